@@ -0,0 +1,80 @@
+
+#include <assert.h>
+//
+#include "pico/binary_info.h"
+#include "i2c_bus/i2c_bus.h"
+//
+#include "mpu6050/mpu6050.h"
+#include "bmp280/bmp280.h"
+#include "aht20/aht20.h"
+#include "ssd1306/display.h"
+
+/*
+Distribuição dos dispositivos I2C:
+
+| Barramento | SDA (GPIO) | SCL (GPIO) | Velocidade | Dispositivos                     |
+| ---------- | ---------- | ---------- | ---------- | -------------------------------- |
+| i2c0       | 0          | 1          | 400 kHz    | MPU6050 0x68, BMP280 0x77, AHT20 0x38 |
+| i2c1       | 14         | 15         | 1 MHz      | SSD1306 0x3C                     |
+
+O display fica sozinho no i2c1: os quadros enviados por DMA ocupam só esse
+barramento, enquanto as leituras dos sensores seguem no i2c0 ao mesmo tempo.
+Nada arbitra o controlador entre o DMA do display e os sensores, então uma
+tabela com o display dividindo barramento é recusada na inicialização
+(i2c_bus_check_config()).
+
+Os dois barramentos pedem Fm+ (1 MHz) e cada dispositivo limita a velocidade
+do seu: MPU6050 e AHT20 só vão até 400 kHz, então o i2c0 fica em fast mode.
+O SSD1306 passa dos 400 kHz do datasheet, mas os módulos comuns aguentam 1 MHz
+com pull-ups externos; se não aguentarem, o barramento recua para 400 kHz no
+primeiro NACK.
+*/
+
+// Configuração dos barramentos
+static i2c_bus_t buses[] = {  // Um para cada controlador usado
+    {
+        .hw_inst = i2c0,  // Controlador I2C
+        .sda_gpio = 0,    // Número do GPIO (não do pino da placa)
+        .scl_gpio = 1,
+        .baud_rate = I2C_BAUD_FAST_PLUS,
+        .internal_pull_up = true
+    },
+    {
+        .hw_inst = i2c1,
+        .sda_gpio = 14,
+        .scl_gpio = 15,
+        .baud_rate = I2C_BAUD_FAST_PLUS,
+        .internal_pull_up = true
+    }};
+
+bi_decl(bi_2pins_with_func(0, 1, GPIO_FUNC_I2C));
+bi_decl(bi_2pins_with_func(14, 15, GPIO_FUNC_I2C));
+
+// Dispositivos e o barramento de cada um
+static i2c_dev_t devices[I2C_NUM_DEVICES] = {
+    [I2C_DEV_MPU6050] = {.name = "MPU6050", .bus = &buses[0], .address = MPU6050_ADDR,
+                         .max_baud_rate = I2C_BAUD_FAST},
+    [I2C_DEV_BMP280] = {.name = "BMP280", .bus = &buses[0], .address = ADDR,
+                        .max_baud_rate = I2C_BAUD_FAST_PLUS},   // Até 3,4 MHz (high speed)
+    [I2C_DEV_AHT20] = {.name = "AHT20", .bus = &buses[0], .address = AHT20_I2C_ADDR,
+                       .max_baud_rate = I2C_BAUD_FAST},
+    [I2C_DEV_SSD1306] = {.name = "SSD1306", .bus = &buses[1], .address = SSD1306_ADDRESS,
+                         .max_baud_rate = I2C_BAUD_FAST_PLUS},
+};
+
+/* ********************************************************************** */
+size_t i2c_bus_get_num() { return count_of(buses); }
+i2c_bus_t *i2c_bus_get_by_num(size_t num) {
+    assert(num < i2c_bus_get_num());
+    if (num < i2c_bus_get_num()) {
+        return &buses[num];
+    } else {
+        return NULL;
+    }
+}
+i2c_dev_t *i2c_dev_get(i2c_dev_id_t id) {
+    assert(id < I2C_NUM_DEVICES);
+    return &devices[id];
+}
+
+/* [] END OF FILE */
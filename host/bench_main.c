@@ -0,0 +1,902 @@
+// Benchmarks do datalogger sobre a HAL simulada.
+//
+// Cada benchmark imprime uma linha JSON em stdout (a saída de printf do
+// firmware é descartada durante a medição). Uso:
+//   datalogger_bench [--data arquivo] [--repeat N] [benchmark ...]
+//
+// Latências "virtual" vêm do relógio simulado (barramentos + cartão SD) e são
+// determinísticas; "cpu_ns" é o tempo de CPU do host e serve só como tendência.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pico/stdlib.h"
+#include "lib/aht20/aht20.h"
+#include "lib/bmp280/bmp280.h"
+#include "lib/i2c_bus/i2c_async.h"
+#include "lib/mpu6050/mpu6050.h"
+#include "lib/sensor/sensor.h"
+#include "lib/sd_card/sd_card_i.h"
+#include "lib/sd_card/csv_record.h"
+#include "lib/ssd1306/ssd1306.h"
+#include "mock_hal.h"
+#include "datalogger_git_rev.h"  // Gerado no build: DATALOGGER_GIT_REV
+
+#define BENCH_SD_SECTORS (64u * 1024u * 2u) // 64 MiB
+#define BENCH_MAX_SAMPLES 4096
+
+typedef struct {
+    const char *data_path;
+    uint32_t repeat;
+    FILE *report;
+} bench_ctx_t;
+
+typedef struct {
+    const char *name;
+    bool (*run)(bench_ctx_t *ctx);
+} bench_t;
+
+// ---------------------------------------------------------------------------
+// Utilitários
+// ---------------------------------------------------------------------------
+
+static mock_mpu6050_sample_t dataset[BENCH_MAX_SAMPLES];
+static size_t dataset_len = 0;
+static size_t dataset_pos = 0;
+
+// Lê o CSV gravado pelo datalogger (ex.: eda/data.txt) de volta para valores crus
+static bool load_dataset(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Não foi possível abrir %s\n", path);
+        return false;
+    }
+
+    char line[160];
+    dataset_len = 0;
+    while (fgets(line, sizeof(line), f) && dataset_len < BENCH_MAX_SAMPLES) {
+        int ax, ay, az, gx, gy, gz;
+        float temp;
+        if (sscanf(line, "%*[^,],%*[^,],%d,%d,%d,%d,%d,%d,%f", &ax, &ay, &az, &gx, &gy, &gz, &temp) != 7)
+            continue; // Cabeçalho ou linha inválida
+
+        mock_mpu6050_sample_t *s = &dataset[dataset_len++];
+        s->accel[0] = (int16_t)ax;
+        s->accel[1] = (int16_t)ay;
+        s->accel[2] = (int16_t)az;
+        s->gyro[0] = (int16_t)gx;
+        s->gyro[1] = (int16_t)gy;
+        s->gyro[2] = (int16_t)gz;
+        s->temp = (int16_t)((temp - 36.53f) * 340.0f);
+    }
+    fclose(f);
+    return dataset_len > 0;
+}
+
+static bool replay_source(void *ctx, mock_mpu6050_sample_t *out)
+{
+    (void)ctx;
+    *out = dataset[dataset_pos];
+    dataset_pos = (dataset_pos + 1) % dataset_len;
+    return true;
+}
+
+static uint64_t cpu_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Percentil pelo método nearest-rank sobre um vetor já ordenado
+static uint64_t percentile(const uint64_t *sorted, size_t n, unsigned pct)
+{
+    size_t rank = (pct * n + 99) / 100;
+    return sorted[rank ? rank - 1 : 0];
+}
+
+static void report_begin(bench_ctx_t *ctx, const char *name)
+{
+    fprintf(ctx->report, "{\"benchmark\":\"%s\",\"git_rev\":\"%s\"", name, DATALOGGER_GIT_REV);
+}
+
+static void report_latency(bench_ctx_t *ctx, const char *prefix, uint64_t *samples, size_t n)
+{
+    qsort(samples, n, sizeof(samples[0]), cmp_u64);
+    fprintf(ctx->report, ",\"%s_p50_ns\":%llu,\"%s_p99_ns\":%llu,\"%s_max_ns\":%llu",
+            prefix, (unsigned long long)percentile(samples, n, 50),
+            prefix, (unsigned long long)percentile(samples, n, 99),
+            prefix, (unsigned long long)samples[n - 1]);
+}
+
+static void report_end(bench_ctx_t *ctx)
+{
+    fprintf(ctx->report, "}\n");
+    fflush(ctx->report);
+}
+
+// ---------------------------------------------------------------------------
+// capture_to_storage: mpu6050_read_raw -> save_data, como no laço de main.c
+// ---------------------------------------------------------------------------
+
+static bool bench_capture_to_storage(bench_ctx_t *ctx)
+{
+    static const char *filename = "bench.csv";
+    size_t n = dataset_len * ctx->repeat;
+    uint64_t *virt = malloc(n * sizeof(uint64_t));
+    uint64_t *cpu = malloc(n * sizeof(uint64_t));
+    if (!virt || !cpu)
+        return false;
+
+    dataset_pos = 0;
+    mock_mpu6050_attach(MPU_6050_I2C_PORT, replay_source, NULL);
+    if (!mock_sd_card_create(BENCH_SD_SECTORS) || !mock_sd_card_format())
+        return false;
+
+    mpu6050_init();
+    run_setrtc("27/07/23 12:00:00");
+    run_mount();
+
+    // Conta só o regime permanente: cabeçalho e alocação do arquivo ficam fora
+    int16_t aceleracao[3], gyro[3], temp;
+    mpu6050_read_raw(aceleracao, gyro, &temp);
+    save_data(filename, aceleracao, gyro, temp);
+    flush_data(filename);
+
+    mock_i2c_reset_stats(MPU_6050_I2C_PORT);
+    mock_sd_reset_stats();
+    FILINFO before;
+    f_stat(filename, &before);
+
+    uint64_t virt_start = time_us_64();
+    uint64_t cpu_start = cpu_now_ns();
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t v0 = mock_clock_now_ns();
+        uint64_t c0 = cpu_now_ns();
+
+        mpu6050_read_raw(aceleracao, gyro, &temp);
+        save_data(filename, aceleracao, gyro, temp);
+
+        cpu[i] = cpu_now_ns() - c0;
+        virt[i] = mock_clock_now_ns() - v0;
+    }
+    flush_data(filename);
+    uint64_t virt_total_us = time_us_64() - virt_start;
+    uint64_t cpu_total_ns = cpu_now_ns() - cpu_start;
+
+    FILINFO after;
+    f_stat(filename, &after);
+    run_unmount();
+
+    const mock_sd_stats_t *sd = mock_sd_get_stats();
+    uint64_t payload = after.fsize - before.fsize;
+
+    report_begin(ctx, "capture_to_storage");
+    fprintf(ctx->report, ",\"samples\":%zu,\"virtual_samples_per_s\":%.1f,\"cpu_ns_per_sample\":%.0f",
+            n, virt_total_us ? n * 1e6 / virt_total_us : 0.0, (double)cpu_total_ns / n);
+    report_latency(ctx, "virtual", virt, n);
+    report_latency(ctx, "cpu", cpu, n);
+    fprintf(ctx->report, ",\"bytes_per_sample\":%.2f,\"sectors_written\":%llu,\"sectors_read\":%llu"
+                         ",\"write_cmds\":%u,\"write_amplification\":%.2f,\"i2c_bytes_per_sample\":%.2f",
+            (double)payload / n, (unsigned long long)sd->sectors_written,
+            (unsigned long long)sd->sectors_read, sd->write_cmds,
+            payload ? (double)sd->sectors_written * 512.0 / payload : 0.0,
+            (double)mock_i2c_get_stats(MPU_6050_I2C_PORT)->bytes / n);
+    report_end(ctx);
+
+    free(virt);
+    free(cpu);
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// record_format: csv_format_record() contra a formatação antiga com sprintf
+// ---------------------------------------------------------------------------
+
+// Formatação usada por save_data() antes do formatador em ponto fixo
+static size_t legacy_format_record(char *dst, const datetime_t *dt, const int16_t accel[3],
+                                   const int16_t gyro[3], int16_t temp_raw)
+{
+    char datetime_str[32];  // Pior caso com campos fora da faixa: ano de 6 e demais de 4 caracteres
+    float temp_celsius = (temp_raw / 340.0f) + 36.53f;
+
+    sprintf(datetime_str, "%04d-%02d-%02d,%02d:%02d:%02d",
+            dt->year, dt->month, dt->day, dt->hour, dt->min, dt->sec);
+    return (size_t)sprintf(dst, "%s,%d,%d,%d,%d,%d,%d,%.2f\n", datetime_str,
+                           accel[0], accel[1], accel[2], gyro[0], gyro[1], gyro[2], temp_celsius);
+}
+
+static inline uint64_t cycles_now(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return cpu_now_ns();
+#endif
+}
+
+static bool bench_record_format(bench_ctx_t *ctx)
+{
+    const size_t iterations = 200000;
+    datetime_t dt = {2023, 7, 27, 4, 12, 0, 16};
+    char out[2][CSV_RECORD_MAX_LEN + 32];
+    volatile size_t sink = 0;
+    uint64_t c0, cycles[2], ns[2];
+
+    size_t (*const formatters[2])(char *, const datetime_t *, const int16_t[3], const int16_t[3], int16_t) = {
+        legacy_format_record, csv_format_record};
+
+    for (int f = 0; f < 2; ++f) {
+        uint64_t t0 = cpu_now_ns();
+        c0 = cycles_now();
+        for (size_t i = 0; i < iterations; ++i) {
+            const mock_mpu6050_sample_t *s = &dataset[i % dataset_len];
+            dt.sec = (int8_t)(i % 60);
+            sink += formatters[f](out[f], &dt, s->accel, s->gyro, s->temp);
+        }
+        cycles[f] = cycles_now() - c0;
+        ns[f] = cpu_now_ns() - t0;
+    }
+
+    // Compara a saída byte a byte em toda a faixa de temperatura crua
+    uint32_t mismatches = 0;
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; ++raw) {
+        const mock_mpu6050_sample_t *s = &dataset[(uint32_t)raw % dataset_len];
+        size_t a = legacy_format_record(out[0], &dt, s->accel, s->gyro, (int16_t)raw);
+        size_t b = csv_format_record(out[1], &dt, s->accel, s->gyro, (int16_t)raw);
+        if (a != b || memcmp(out[0], out[1], a))
+            mismatches++;
+    }
+
+    report_begin(ctx, "record_format");
+    fprintf(ctx->report, ",\"records\":%zu,\"legacy_ns_per_record\":%.1f,\"fixed_ns_per_record\":%.1f"
+                         ",\"legacy_cycles_per_record\":%.1f,\"fixed_cycles_per_record\":%.1f"
+                         ",\"speedup\":%.2f,\"temp_range_mismatches\":%u",
+            iterations, (double)ns[0] / iterations, (double)ns[1] / iterations,
+            (double)cycles[0] / iterations, (double)cycles[1] / iterations,
+            ns[1] ? (double)ns[0] / ns[1] : 0.0, mismatches);
+    report_end(ctx);
+    return sink > 0;
+}
+
+// ---------------------------------------------------------------------------
+// display_render: quadro de update_display() (tela de captura) desenhado com
+// as primitivas por byte contra as antigas, pixel a pixel
+// ---------------------------------------------------------------------------
+
+static void legacy_pixel(uint8_t *buf, uint8_t x, uint8_t y, bool value)
+{
+    uint16_t index = (y >> 3) + (x << 3) + 1;
+    uint8_t pixel = (y & 0b111);
+    if (value)
+        buf[index] |= (1 << pixel);
+    else
+        buf[index] &= ~(1 << pixel);
+}
+
+static void legacy_line(uint8_t *buf, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
+{
+    int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    int sx = (x0 < x1) ? 1 : -1, sy = (y0 < y1) ? 1 : -1;
+    int err = dx - dy;
+
+    while (true) {
+        legacy_pixel(buf, x0, y0, value);
+        if (x0 == x1 && y0 == y1)
+            break;
+        int e2 = err * 2;
+        if (e2 > -dy) {
+            err -= dy;
+            x0 += sx;
+        }
+        if (e2 < dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+static void legacy_text(uint8_t *buf, const char *text, uint8_t y)
+{
+    uint8_t x = (uint8_t)((128 - strlen(text) * 8) / 2);
+    for (; *text; ++text, x += 8) {
+        uint16_t index = (*text >= ' ' && *text <= '~') ? (uint16_t)((*text - ' ') * 8) : 0;
+        for (uint8_t i = 0; i < 8; ++i)
+            for (uint8_t j = 0; j < 8; ++j)
+                legacy_pixel(buf, x + i, y + j, font_8x8.data[index + i] & (1 << j));
+    }
+}
+
+static void render_frame_legacy(uint8_t *buf, const char *count)
+{
+    for (uint8_t y = 0; y < HEIGHT; ++y)
+        for (uint8_t x = 0; x < WIDTH; ++x)
+            legacy_pixel(buf, x, y, false);
+    for (uint8_t x = 3; x < 3 + 122; ++x) {
+        legacy_pixel(buf, x, 3, true);
+        legacy_pixel(buf, x, 3 + 60 - 1, true);
+    }
+    for (uint8_t y = 3; y < 3 + 60; ++y) {
+        legacy_pixel(buf, 3, y, true);
+        legacy_pixel(buf, 3 + 122 - 1, y, true);
+    }
+    legacy_line(buf, 3, 15, 123, 15, true);
+    legacy_text(buf, "DATALOGGER", 6);
+    legacy_line(buf, 3, 48, 123, 48, true);
+    legacy_text(buf, "Amostras:", 20);
+    legacy_text(buf, count, 30);
+    legacy_text(buf, "Capturando...", 52);
+}
+
+static void centered(ssd1306_t *ssd, const char *text, uint8_t y)
+{
+    ssd1306_draw_string(ssd, text, (uint8_t)((128 - strlen(text) * 8) / 2), y);
+}
+
+// Mesma sequência de chamadas de update_display() no modo de captura
+static void render_frame(ssd1306_t *ssd, const char *count)
+{
+    ssd1306_fill(ssd, false);
+    ssd1306_rect(ssd, 3, 3, 122, 60, true, false);
+    ssd1306_line(ssd, 3, 15, 123, 15, true);
+    centered(ssd, "DATALOGGER", 6);
+    ssd1306_line(ssd, 3, 48, 123, 48, true);
+    centered(ssd, "Amostras:", 20);
+    centered(ssd, count, 30);
+    centered(ssd, "Capturando...", 52);
+}
+
+static bool bench_display_render(bench_ctx_t *ctx)
+{
+    const size_t iterations = 20000;
+    ssd1306_t ssd;
+    uint8_t legacy_buf[WIDTH * SSD1306_MAX_PAGES + 1] = {0x40};
+    char count[12];
+    volatile uint8_t sink = 0;
+    uint64_t t0, c0, ns[2], cycles[2];
+
+    SSD1306_FRAMEBUFFER(bench_fb, WIDTH, HEIGHT);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, 0x3C, i2c1, &bench_fb);
+
+    t0 = cpu_now_ns();
+    c0 = cycles_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        snprintf(count, sizeof(count), "%zu", i);
+        render_frame_legacy(legacy_buf, count);
+        sink ^= legacy_buf[1 + (i & 1023)];
+    }
+    cycles[0] = cycles_now() - c0;
+    ns[0] = cpu_now_ns() - t0;
+
+    t0 = cpu_now_ns();
+    c0 = cycles_now();
+    for (size_t i = 0; i < iterations; ++i) {
+        snprintf(count, sizeof(count), "%zu", i);
+        render_frame(&ssd, count);
+        sink ^= ssd.ram_buffer[1 + (i & 1023)];
+    }
+    cycles[1] = cycles_now() - c0;
+    ns[1] = cpu_now_ns() - t0;
+
+    // Os dois caminhos precisam produzir o mesmo framebuffer
+    uint32_t mismatches = 0;
+    for (size_t i = 0; i < 1000; ++i) {
+        snprintf(count, sizeof(count), "%zu", i * 7919);
+        render_frame_legacy(legacy_buf, count);
+        render_frame(&ssd, count);
+        mismatches += memcmp(legacy_buf + 1, ssd.ram_buffer + 1, ssd.bufsize - 1) != 0;
+    }
+
+    report_begin(ctx, "display_render");
+    fprintf(ctx->report, ",\"frames\":%zu,\"legacy_ns_per_frame\":%.1f,\"bytewise_ns_per_frame\":%.1f"
+                         ",\"legacy_cycles_per_frame\":%.1f,\"bytewise_cycles_per_frame\":%.1f"
+                         ",\"speedup\":%.2f,\"framebuffer_mismatches\":%u",
+            iterations, (double)ns[0] / iterations, (double)ns[1] / iterations,
+            (double)cycles[0] / iterations, (double)cycles[1] / iterations,
+            ns[1] ? (double)ns[0] / ns[1] : 0.0, mismatches);
+    report_end(ctx);
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// aht20_convert: conversão do AHT20 em ponto fixo contra a antiga em float,
+// conferida contra o valor exato em toda a faixa crua de 20 bits
+// ---------------------------------------------------------------------------
+
+#define AHT20_RAW_RANGE (1u << 20)
+
+// Conversão usada por aht20_decode() antes do ponto fixo
+static int32_t legacy_to_centi(float value)
+{
+    return (int32_t)(value >= 0.0f ? value * 100.0f + 0.5f : value * 100.0f - 0.5f);
+}
+
+static int32_t legacy_humidity(uint32_t raw)
+{
+    return legacy_to_centi((float)raw * 100.0 / 1048576.0);
+}
+
+static int32_t legacy_temp(uint32_t raw)
+{
+    return legacy_to_centi(((float)raw * 200.0 / 1048576.0) - 50.0);
+}
+
+// raw * 625 / 2^16 e raw * 1250 / 2^16 são exatos em double
+static int32_t exact_round(double x)
+{
+    return (int32_t)(x >= 0 ? floor(x + 0.5) : -floor(-x + 0.5));
+}
+
+static bool bench_aht20_convert(bench_ctx_t *ctx)
+{
+    const uint32_t passes = 4;
+    volatile uint32_t sink = 0;
+    uint64_t t0, c0, ns[2], cycles[2];
+
+    int32_t (*const humidity[2])(uint32_t) = {legacy_humidity, aht20_humidity_centi_percent};
+    int32_t (*const temp[2])(uint32_t) = {legacy_temp, aht20_temp_centi_celsius};
+
+    for (int f = 0; f < 2; ++f) {
+        t0 = cpu_now_ns();
+        c0 = cycles_now();
+        for (uint32_t p = 0; p < passes; ++p)
+            for (uint32_t raw = 0; raw < AHT20_RAW_RANGE; ++raw)
+                sink += (uint32_t)(humidity[f](raw) + temp[f](raw));
+        cycles[f] = cycles_now() - c0;
+        ns[f] = cpu_now_ns() - t0;
+    }
+
+    uint32_t exact_mismatches = 0, legacy_mismatches = 0;
+    for (uint32_t raw = 0; raw < AHT20_RAW_RANGE; ++raw) {
+        int32_t h = aht20_humidity_centi_percent(raw);
+        int32_t t = aht20_temp_centi_celsius(raw);
+        exact_mismatches += h != exact_round(raw * 625.0 / 65536.0);
+        exact_mismatches += t != exact_round(raw * 1250.0 / 65536.0 - 5000.0);
+        legacy_mismatches += h != legacy_humidity(raw);
+        legacy_mismatches += t != legacy_temp(raw);
+    }
+
+    const double conversions = 2.0 * passes * AHT20_RAW_RANGE;
+    report_begin(ctx, "aht20_convert");
+    fprintf(ctx->report, ",\"conversions\":%.0f,\"float_ns_per_conversion\":%.2f,\"fixed_ns_per_conversion\":%.2f"
+                         ",\"float_cycles_per_conversion\":%.2f,\"fixed_cycles_per_conversion\":%.2f"
+                         ",\"speedup\":%.2f,\"exact_mismatches\":%u,\"float_mismatches\":%u",
+            conversions, ns[0] / conversions, ns[1] / conversions,
+            cycles[0] / conversions, cycles[1] / conversions,
+            ns[1] ? (double)ns[0] / ns[1] : 0.0, exact_mismatches, legacy_mismatches);
+    report_end(ctx);
+    return exact_mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// bmp280_compensate: compensação por amostra com t_fine recalculado contra a
+// compensação em lote com calibração do dispositivo; ambas conferidas contra
+// o exemplo do datasheet
+// ---------------------------------------------------------------------------
+
+#define BMP280_BATCH 256
+
+// Exemplo de compensação do datasheet (seção 8.2)
+static const struct bmp280_calib_param datasheet_calib = {
+    27504, 26435, -1000, 36477, -10685, 3024, 2855, 140, -7, 15500, -14600, 6000,
+};
+#define DATASHEET_ADC_T 519888
+#define DATASHEET_ADC_P 415148
+#define DATASHEET_T_FINE 128422
+#define DATASHEET_TEMP 2508          // 25,08 °C
+#define DATASHEET_PRESSURE 10065327  // 100653,27 Pa (fórmula em ponto flutuante), em centésimos
+#define PRESSURE64_TOLERANCE 10      // centésimos de Pa
+
+static bool bench_bmp280_compensate(bench_ctx_t *ctx)
+{
+    const size_t batches = 2000;
+    struct bmp280_calib_param calib = datasheet_calib;
+    bmp280_t dev = {.calib = datasheet_calib};
+    static int32_t raw_temp[BMP280_BATCH], raw_pressure[BMP280_BATCH], temp[BMP280_BATCH];
+    static uint32_t pressure[BMP280_BATCH];
+    volatile uint32_t sink = 0;
+    uint64_t t0, c0, ns[2], cycles[2];
+
+    // Faixa de operação em torno do exemplo: cerca de ±5 °C e ±4 kPa
+    for (size_t i = 0; i < BMP280_BATCH; ++i) {
+        raw_temp[i] = DATASHEET_ADC_T + (int32_t)(i * 97 % 20000) - 10000;
+        raw_pressure[i] = DATASHEET_ADC_P + (int32_t)(i * 61 % 16000) - 8000;
+    }
+
+    t0 = cpu_now_ns();
+    c0 = cycles_now();
+    for (size_t b = 0; b < batches; ++b)
+        for (size_t i = 0; i < BMP280_BATCH; ++i)
+            sink += (uint32_t)bmp280_convert_temp(raw_temp[i], &calib) +
+                    (uint32_t)bmp280_convert_pressure(raw_pressure[i], raw_temp[i], &calib);
+    cycles[0] = cycles_now() - c0;
+    ns[0] = cpu_now_ns() - t0;
+
+    t0 = cpu_now_ns();
+    c0 = cycles_now();
+    for (size_t b = 0; b < batches; ++b) {
+        bmp280_compensate_batch(&dev, raw_temp, raw_pressure, temp, pressure, BMP280_BATCH);
+        sink += (uint32_t)temp[b % BMP280_BATCH] + pressure[b % BMP280_BATCH];
+    }
+    cycles[1] = cycles_now() - c0;
+    ns[1] = cpu_now_ns() - t0;
+
+    // t_fine e temperatura são exatos; a pressão do caminho de 64 bits fica a
+    // menos de PRESSURE64_TOLERANCE do valor do datasheet. O de 32 bits só
+    // precisa coincidir com a conversão antiga; seu erro vai para o relatório.
+    uint32_t mismatches = 0;
+    int32_t t = bmp280_compensate_temp(&dev, DATASHEET_ADC_T);
+    mismatches += dev.t_fine != DATASHEET_T_FINE;
+    mismatches += t != DATASHEET_TEMP;
+    mismatches += bmp280_convert_temp(DATASHEET_ADC_T, &calib) != DATASHEET_TEMP;
+
+    uint32_t p32 = bmp280_compensate_pressure(&dev, DATASHEET_ADC_P);
+    int64_t p64_centipa = ((int64_t)bmp280_compensate_pressure64(&dev, DATASHEET_ADC_P) * 100 + 128) >> 8;
+    int64_t p32_error = (int64_t)p32 * 100 - DATASHEET_PRESSURE;
+    int64_t p64_error = p64_centipa - DATASHEET_PRESSURE;
+    mismatches += (int32_t)p32 != bmp280_convert_pressure(DATASHEET_ADC_P, DATASHEET_ADC_T, &calib);
+    mismatches += p64_error > PRESSURE64_TOLERANCE || p64_error < -PRESSURE64_TOLERANCE;
+
+    int32_t one_t = DATASHEET_ADC_T, one_p = DATASHEET_ADC_P;
+    bmp280_compensate_batch(&dev, &one_t, &one_p, temp, pressure, 1);
+    mismatches += temp[0] != DATASHEET_TEMP ||
+                  pressure[0] != bmp280_compensate_pressure64(&dev, DATASHEET_ADC_P);
+
+    // Diferença entre os caminhos de 32 e 64 bits na faixa de operação
+    uint32_t max_diff_centipa = 0;
+    for (size_t i = 0; i < BMP280_BATCH; ++i) {
+        bmp280_compensate_temp(&dev, raw_temp[i]);
+        int64_t p32 = (int64_t)bmp280_compensate_pressure(&dev, raw_pressure[i]) * 100;
+        int64_t p64 = ((int64_t)bmp280_compensate_pressure64(&dev, raw_pressure[i]) * 100 + 128) >> 8;
+        uint32_t diff = (uint32_t)(p32 > p64 ? p32 - p64 : p64 - p32);
+        if (diff > max_diff_centipa)
+            max_diff_centipa = diff;
+    }
+
+    const double samples = (double)batches * BMP280_BATCH;
+    report_begin(ctx, "bmp280_compensate");
+    fprintf(ctx->report, ",\"samples\":%.0f,\"per_sample_ns\":%.1f,\"batch_ns\":%.1f"
+                         ",\"per_sample_cycles\":%.1f,\"batch_cycles\":%.1f,\"speedup\":%.2f"
+                         ",\"datasheet_mismatches\":%u,\"p32_error_centipa\":%lld,\"p64_error_centipa\":%lld"
+                         ",\"max_32_vs_64_centipa\":%u",
+            samples, ns[0] / samples, ns[1] / samples, cycles[0] / samples, cycles[1] / samples,
+            ns[1] ? (double)ns[0] / ns[1] : 0.0, mismatches, (long long)p32_error,
+            (long long)p64_error, max_diff_centipa);
+    report_end(ctx);
+    return mismatches == 0;
+}
+
+// ---------------------------------------------------------------------------
+// i2c_async_read: rajadas do MPU6050 (14 bytes) e do BMP280 (10 bytes) com
+// leituras bloqueantes contra a fila de leituras por DMA. Os bytes lidos pelos
+// dois caminhos são comparados; um descritor para um dispositivo que não
+// responde precisa falhar sem travar a fila.
+// ---------------------------------------------------------------------------
+
+static uint32_t async_callbacks;
+
+static void count_callback(i2c_xfer_t *xfer)
+{
+    (void)xfer;
+    async_callbacks++;
+}
+
+static bool blocking_burst(i2c_dev_id_t id, uint8_t reg, uint8_t *dst, size_t len)
+{
+    i2c_inst_t *i2c = i2c_dev_port(id);
+    uint8_t addr = i2c_dev_get(id)->address;
+    return i2c_write_blocking(i2c, addr, &reg, 1, true) == 1 &&
+           i2c_read_blocking(i2c, addr, dst, len, false) == (int)len;
+}
+
+static bool bench_i2c_async_read(bench_ctx_t *ctx)
+{
+    const size_t rounds = 1000;
+    static bmp280_t bmp;
+    uint8_t mpu_ref[14], mpu_dma[14], bmp_ref[BMP280_BURST_LEN], bmp_dma[BMP280_BURST_LEN];
+    i2c_xfer_t xfers[2] = {
+        {.dev = I2C_DEV_MPU6050, .reg = 0x3B, .len = sizeof(mpu_dma), .dst = mpu_dma, .done = count_callback},
+        {.dev = I2C_DEV_BMP280, .reg = 0xF3, .len = sizeof(bmp_dma), .dst = bmp_dma, .done = count_callback},
+    };
+    uint64_t blocking_ns = 0, setup_ns = 0, bus_ns = 0, setup_cpu_ns = 0;
+    uint32_t mismatches = 0;
+
+    mock_mpu6050_attach(MPU_6050_I2C_PORT, replay_source, NULL);
+    mock_bmp280_attach(BMP280_I2C_PORT);
+    mpu6050_init();
+    if (!bmp280_begin(&bmp, i2c_dev_init(I2C_DEV_BMP280)))
+        return false;
+    sleep_ms(100);  // Primeira conversão contínua do BMP280
+
+    const i2c_async_stats_t before = *i2c_async_get_stats();
+    async_callbacks = 0;
+    for (size_t i = 0; i < rounds; ++i) {
+        uint64_t v0 = mock_clock_now_ns();
+        dataset_pos = i % dataset_len;
+        mismatches += !blocking_burst(I2C_DEV_MPU6050, 0x3B, mpu_ref, sizeof(mpu_ref));
+        mismatches += !blocking_burst(I2C_DEV_BMP280, 0xF3, bmp_ref, sizeof(bmp_ref));
+        blocking_ns += mock_clock_now_ns() - v0;
+
+        dataset_pos = i % dataset_len;
+        uint64_t c0 = cpu_now_ns();
+        v0 = mock_clock_now_ns();
+        for (int x = 0; x < 2; ++x)
+            mismatches += !i2c_async_submit(&xfers[x]);
+        setup_ns += mock_clock_now_ns() - v0;
+        setup_cpu_ns += cpu_now_ns() - c0;
+
+        while (i2c_xfer_pending(&xfers[0]) || i2c_xfer_pending(&xfers[1])) {
+            sleep_us(10);
+            i2c_async_poll();
+        }
+        bus_ns += mock_clock_now_ns() - v0;
+
+        mismatches += xfers[0].status != I2C_XFER_DONE || memcmp(mpu_ref, mpu_dma, sizeof(mpu_ref));
+        // No modo normal o BMP280 simulado converte a cada leitura: só o
+        // status e o controle se repetem, e a rajada precisa passar pelas conferências
+        int32_t temp, pressure;
+        mismatches += xfers[1].status != I2C_XFER_DONE || memcmp(bmp_ref, bmp_dma, 4) ||
+                      bmp280_parse_burst(&bmp, bmp_dma, &temp, &pressure) != BMP280_OK;
+    }
+    const i2c_async_stats_t *after = i2c_async_get_stats();
+    uint32_t transfers = after->transfers - before.transfers;
+    uint32_t blocking = after->blocking - before.blocking;
+
+    // O display não responde a leituras: NACK, descritor falho e fila livre
+    uint8_t scratch[4];
+    i2c_xfer_t nack = {.dev = I2C_DEV_SSD1306, .reg = 0x00, .len = sizeof(scratch), .dst = scratch};
+    i2c_async_submit(&nack);
+    i2c_async_flush(i2c_dev_port(I2C_DEV_SSD1306));
+    bool nack_ok = nack.status == I2C_XFER_FAILED;
+
+    report_begin(ctx, "i2c_async_read");
+    fprintf(ctx->report, ",\"rounds\":%zu,\"bytes_per_round\":%u,\"blocking_cpu_us_per_round\":%.1f"
+                         ",\"dma_setup_us_per_round\":%.1f,\"dma_bus_us_per_round\":%.1f"
+                         ",\"dma_setup_host_ns\":%.0f,\"transfers\":%u,\"callbacks\":%u"
+                         ",\"without_dma\":%u,\"mismatches\":%u,\"nack_detected\":%s",
+            rounds, (unsigned)(sizeof(mpu_ref) + sizeof(bmp_ref)), blocking_ns / 1e3 / rounds,
+            setup_ns / 1e3 / rounds, bus_ns / 1e3 / rounds, (double)setup_cpu_ns / rounds, transfers,
+            async_callbacks, blocking, mismatches, nack_ok ? "true" : "false");
+    report_end(ctx);
+    return mismatches == 0 && nack_ok && blocking == 0 && transfers == 2 * rounds &&
+           async_callbacks == 2 * rounds;
+}
+
+// ---------------------------------------------------------------------------
+// i2c_speed: tempo de um quadro completo do OLED em 100 kHz, 400 kHz e 1 MHz
+// (Fm+), com os tempos do modo de medição, e o recuo para 400 kHz quando o
+// barramento não aguenta 1 MHz, nos caminhos por DMA e bloqueante
+// ---------------------------------------------------------------------------
+
+static uint64_t oled_frame_ns(ssd1306_t *ssd, i2c_bus_t *bus, uint baud, size_t frames)
+{
+    bus->actual_baud_rate = i2c_set_baudrate(bus->hw_inst, baud);
+    uint64_t v0 = mock_clock_now_ns();
+    for (size_t i = 0; i < frames; ++i) {
+        ssd1306_fill(ssd, i & 1);  // Alterna o quadro inteiro: todas as colunas mudam
+        ssd1306_send_data(ssd);
+    }
+    return (mock_clock_now_ns() - v0) / frames;
+}
+
+static bool bench_i2c_speed(bench_ctx_t *ctx)
+{
+    const size_t frames = 50;
+    static const uint speeds[] = {I2C_BAUD_STANDARD, I2C_BAUD_FAST, I2C_BAUD_FAST_PLUS};
+    uint64_t frame_ns[count_of(speeds)];
+    ssd1306_t ssd;
+
+    SSD1306_FRAMEBUFFER(speed_fb, WIDTH, HEIGHT);
+    i2c_bus_t *bus = i2c_dev_get(I2C_DEV_SSD1306)->bus;
+    i2c_inst_t *i2c = i2c_dev_init(I2C_DEV_SSD1306);
+    uint8_t address = i2c_dev_get(I2C_DEV_SSD1306)->address;
+    mock_ssd1306_attach(i2c, address);
+    ssd1306_init(&ssd, WIDTH, HEIGHT, false, address, i2c, &speed_fb);
+    ssd1306_config(&ssd);
+
+    for (size_t s = 0; s < count_of(speeds); ++s) {
+        i2c_bus_set_measure(speeds[s] == I2C_BAUD_FAST_PLUS);
+        frame_ns[s] = oled_frame_ns(&ssd, bus, speeds[s], frames);
+    }
+    i2c_bus_stats_t measured = bus->stats;
+    i2c_bus_set_measure(false);
+
+    // Barramento que só aguenta 400 kHz: o quadro por DMA recebe NACK e, no
+    // envio seguinte, o mesmo quadro vai de novo em 400 kHz (o painel, aceso
+    // pelo último quadro medido, só apaga se o reenvio chegar); depois um
+    // comando bloqueante recua na hora
+    mock_i2c_set_max_baudrate(i2c, I2C_BAUD_FAST);
+    bus->actual_baud_rate = i2c_set_baudrate(i2c, I2C_BAUD_FAST_PLUS);
+    uint32_t fallbacks = bus->stats.fallbacks;
+    bool dma = ssd1306_enable_dma(&ssd);
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        ssd1306_fill(&ssd, false);
+        ssd1306_send_data(&ssd);
+        while (ssd1306_busy(&ssd))
+            sleep_us(100);
+    }
+    bool dma_ok = dma && bus->actual_baud_rate == I2C_BAUD_FAST && !mock_ssd1306_pixel(0, 0);
+
+    bus->actual_baud_rate = i2c_set_baudrate(i2c, I2C_BAUD_FAST_PLUS);
+    uint32_t commands = mock_ssd1306_get_state()->commands;
+    ssd1306_command(&ssd, SET_ENTIRE_ON);
+    bool blocking_ok = bus->actual_baud_rate == I2C_BAUD_FAST &&
+                       mock_ssd1306_get_state()->commands == commands + 1;
+    fallbacks = bus->stats.fallbacks - fallbacks;
+
+    mock_i2c_set_max_baudrate(i2c, 0);
+    bus->actual_baud_rate = i2c_set_baudrate(i2c, i2c_bus_target_baud(bus));
+    if (dma)
+        dma_channel_unclaim(ssd.dma_chan);
+
+    double ratio = (double)frame_ns[2] / frame_ns[1];
+    report_begin(ctx, "i2c_speed");
+    fprintf(ctx->report, ",\"frames\":%zu,\"frame_us_100k\":%.1f,\"frame_us_400k\":%.1f,\"frame_us_1m\":%.1f"
+                         ",\"ratio_1m_vs_400k\":%.2f,\"measured_transactions\":%u,\"measured_avg_us\":%.1f"
+                         ",\"measured_max_us\":%u,\"fallbacks\":%u,\"dma_fallback\":%s,\"blocking_fallback\":%s",
+            frames, frame_ns[0] / 1e3, frame_ns[1] / 1e3, frame_ns[2] / 1e3, ratio, measured.timed,
+            measured.timed ? (double)measured.busy_us / measured.timed : 0.0, measured.max_us, fallbacks,
+            dma_ok ? "true" : "false", blocking_ok ? "true" : "false");
+    report_end(ctx);
+    return ratio < 0.5 && dma_ok && blocking_ok && fallbacks == 2;
+}
+
+// ---------------------------------------------------------------------------
+// i2c_recovery: amostras perdidas quando o barramento dos sensores trava (SDA
+// preso) numa leitura por DMA e numa bloqueante, quando o MPU6050 some do
+// barramento e volta recém-energizado (em sleep), e os contadores do BMP280
+// numa reinicialização
+// ---------------------------------------------------------------------------
+
+// Roda o escalonador por periods períodos do sensor; retorna as amostras novas
+static uint32_t run_sensor(sensor_sched_t *sched, sensor_t *s, uint32_t periods)
+{
+    uint64_t end = time_us_64() + (uint64_t)periods * s->period_us;
+    uint32_t samples = 0;
+
+    while (time_us_64() < end) {
+        if (sensor_sched_poll(sched, time_us_64()) & SENSOR_BIT(s))
+            samples++;
+        uint64_t next = sensor_sched_next_us(sched);
+        if (next > end)
+            next = end;
+        if (next > time_us_64())
+            sleep_us(next - time_us_64());
+    }
+    return samples;
+}
+
+static bool bench_i2c_recovery(bench_ctx_t *ctx)
+{
+    const uint32_t periods = 100, period_us = 10000;
+    static sensor_sched_t sched;
+    static sensor_t mpu;
+    i2c_inst_t *i2c = MPU_6050_I2C_PORT;
+    const i2c_bus_t *bus = i2c_bus_of(i2c);
+    int16_t accel[3], gyro[3], temp;
+
+    mock_mpu6050_attach(i2c, NULL, NULL);
+    mpu6050_init();
+    sensor_sched_init(&sched);
+    if (!sensor_sched_add(&sched, &mpu, &mpu6050_sensor, NULL, period_us))
+        return false;
+    uint32_t recoveries = bus->recoveries;
+
+    // Trava no meio da captura: a rajada por DMA vence o timeout
+    mock_i2c_hang(i2c, time_us_64() + periods / 2 * period_us + 1, bus->sda_gpio, bus->scl_gpio);
+    uint32_t dma_lost = periods - run_sensor(&sched, &mpu, periods);
+
+    // Trava antes de uma leitura bloqueante: ela falha no timeout, não fica presa
+    mock_i2c_hang(i2c, 0, bus->sda_gpio, bus->scl_gpio);
+    uint64_t v0 = mock_clock_now_ns();
+    bool blocking_failed = !mpu6050_read_raw(accel, gyro, &temp);
+    uint64_t blocking_ns = mock_clock_now_ns() - v0;
+    bool blocking_ok = blocking_failed && !mock_i2c_hung(i2c) && mpu6050_read_raw(accel, gyro, &temp);
+    recoveries = bus->recoveries - recoveries;
+
+    // MPU6050 fora do barramento: falhas e tentativas de reinicialização a
+    // cada período; ao voltar em sleep, só a reinicialização o acorda
+    uint32_t errors = mpu.stats.errors, reinits = mpu.stats.reinits;
+    mock_mpu6050_set_connected(false);
+    uint32_t absent_samples = run_sensor(&sched, &mpu, periods / 2);
+    mock_mpu6050_set_connected(true);
+    uint32_t served = mock_mpu6050_samples_served();
+    uint32_t back_lost = periods - run_sensor(&sched, &mpu, periods);
+    bool awake = mock_mpu6050_samples_served() - served >= periods - back_lost && mpu.values[2] != 0;
+    errors = mpu.stats.errors - errors;
+    reinits = mpu.stats.reinits - reinits;
+
+    // BMP280 reiniciado sozinho (soft reset): a leitura seguinte detecta a
+    // configuração perdida, e a reinicialização preserva essa evidência
+    static bmp280_t bmp;
+    uint8_t reset_cmd[2] = {0xE0, 0xB6};
+    int32_t raw_temp, raw_pressure;
+    mock_bmp280_attach(BMP280_I2C_PORT);
+    bool bmp_counters = bmp280_begin(&bmp, i2c_dev_init(I2C_DEV_BMP280)) &&
+                        i2c_bus_write(bmp.i2c, i2c_dev_get(I2C_DEV_BMP280)->address, reset_cmd, 2, false) == 2 &&
+                        bmp280_read_burst(&bmp, &raw_temp, &raw_pressure) == BMP280_ERROR &&
+                        bmp.reconfigs == 1 && bmp280_begin(&bmp, bmp.i2c) && bmp.reconfigs == 1;
+
+    report_begin(ctx, "i2c_recovery");
+    fprintf(ctx->report, ",\"period_us\":%u,\"periods\":%u,\"dma_hang_lost\":%u,\"blocking_hang_us\":%.1f"
+                         ",\"blocking_recovered\":%s,\"recoveries\":%u,\"absent_samples\":%u"
+                         ",\"absent_errors\":%u,\"reinits\":%u,\"lost_after_reconnect\":%u,\"awake\":%s"
+                         ",\"bmp280_counters_kept\":%s",
+            period_us, periods, dma_lost, blocking_ns / 1e3, blocking_ok ? "true" : "false", recoveries,
+            absent_samples, errors, reinits, back_lost, awake ? "true" : "false", bmp_counters ? "true" : "false");
+    report_end(ctx);
+    return dma_lost <= 1 && blocking_ok && recoveries == 2 && absent_samples == 0 && reinits == 1 &&
+           back_lost <= SENSOR_REINIT_ERRORS && awake && bmp_counters;
+}
+
+// ---------------------------------------------------------------------------
+
+static const bench_t benchmarks[] = {
+    {"capture_to_storage", bench_capture_to_storage},
+    {"record_format", bench_record_format},
+    {"display_render", bench_display_render},
+    {"aht20_convert", bench_aht20_convert},
+    {"bmp280_compensate", bench_bmp280_compensate},
+    {"i2c_async_read", bench_i2c_async_read},
+    {"i2c_speed", bench_i2c_speed},
+    {"i2c_recovery", bench_i2c_recovery},
+};
+
+int main(int argc, char **argv)
+{
+    bench_ctx_t ctx = {
+        .data_path = DATALOGGER_DEFAULT_DATASET,
+        .repeat = 5,
+    };
+    const char *selected[count_of(benchmarks)];
+    size_t num_selected = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--data") && i + 1 < argc) {
+            ctx.data_path = argv[++i];
+        } else if (!strcmp(argv[i], "--repeat") && i + 1 < argc) {
+            ctx.repeat = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (argv[i][0] != '-' && num_selected < count_of(selected)) {
+            selected[num_selected++] = argv[i];
+        } else {
+            fprintf(stderr, "uso: %s [--data arquivo] [--repeat N] [benchmark ...]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (ctx.repeat == 0 || !load_dataset(ctx.data_path))
+        return 1;
+    if (dataset_len * ctx.repeat > BENCH_MAX_SAMPLES * 16u)
+        ctx.repeat = (BENCH_MAX_SAMPLES * 16u) / dataset_len;
+
+    // O relatório vai para o stdout original; o printf do firmware é descartado
+    ctx.report = fdopen(dup(STDOUT_FILENO), "w");
+    if (!ctx.report || !freopen("/dev/null", "w", stdout))
+        return 1;
+
+    // run_mount() usa strtok(NULL, ...) sem chamada anterior
+    static char strtok_seed[] = "";
+    strtok(strtok_seed, " ");
+
+    int failures = 0;
+    for (size_t b = 0; b < count_of(benchmarks); ++b) {
+        bool wanted = num_selected == 0;
+        for (size_t s = 0; s < num_selected; ++s)
+            wanted |= !strcmp(selected[s], benchmarks[b].name);
+        if (wanted && !benchmarks[b].run(&ctx)) {
+            fprintf(stderr, "benchmark %s falhou\n", benchmarks[b].name);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
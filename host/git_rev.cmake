@@ -0,0 +1,19 @@
+# Gera o cabeçalho com o commit atual, chamado a cada build pelo alvo
+# datalogger_git_rev. Só reescreve o arquivo quando o commit muda, para não
+# recompilar os benchmarks à toa.
+# Uso: cmake -DREPO_ROOT=... -DOUTPUT=.../datalogger_git_rev.h -P git_rev.cmake
+
+execute_process(
+        COMMAND git rev-parse --short HEAD
+        WORKING_DIRECTORY ${REPO_ROOT}
+        OUTPUT_VARIABLE DATALOGGER_GIT_REV
+        OUTPUT_STRIP_TRAILING_WHITESPACE
+        ERROR_QUIET
+)
+if(NOT DATALOGGER_GIT_REV)
+    set(DATALOGGER_GIT_REV unknown)
+endif()
+
+file(WRITE ${OUTPUT}.tmp "#define DATALOGGER_GIT_REV \"${DATALOGGER_GIT_REV}\"\n")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
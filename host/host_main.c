@@ -0,0 +1,165 @@
+// Executável host: roda o laço do datalogger (main.c) sobre a HAL simulada.
+//
+// Cenário: monta o SD (botão A), inicia a captura (botão B), encerra a captura
+// após --capture-s segundos e finaliza a simulação. Uso:
+//   datalogger_host [--capture-s N] [--image arquivo.img] [--usb-stalled] [--console teclas]
+//                   [--frames dir] [--snapshot arquivo.pbm] [--expect arquivo.pbm]
+//                   [--i2c-fault-s N]
+//
+// --usb-stalled simula um terminal conectado que não lê a porta serial.
+// --console entrega as teclas ao terminal, uma por volta do laço principal.
+// --frames grava um PBM do painel virtual a cada quadro (dir/frame_NNNN.pbm).
+// --snapshot grava o estado final do painel; --expect o compara com um PBM de
+// referência e termina com código 3 se algum pixel for diferente.
+// --i2c-fault-s trava o barramento dos sensores (SDA preso em nível baixo) N
+// segundos após o início da captura.
+
+#include <setjmp.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "lib/button/button.h"
+#include "lib/mpu6050/mpu6050.h"
+#include "lib/bmp280/bmp280.h"
+#include "lib/aht20/aht20.h"
+#include "lib/ultrasonic/ultrasonic.h"
+#include "lib/ssd1306/display.h"
+#include "lib/trace/trace.h"
+#include "lib/live_stream/live_stream.h"
+#include "mock_hal.h"
+
+#define HOST_SD_SECTORS (64u * 1024u * 2u) // 64 MiB
+
+int datalogger_main(void);
+
+static jmp_buf sim_end;
+
+static void on_deadline(void)
+{
+    longjmp(sim_end, 1);
+}
+
+static void save_frame(const mock_ssd1306_frame_t *frame, void *ctx)
+{
+    char path[512];
+    snprintf(path, sizeof(path), "%s/frame_%04u.pbm", (const char *)ctx, frame->index);
+    if (!mock_ssd1306_save_pbm(path))
+        fprintf(stderr, "Falha ao salvar o quadro em %s\n", path);
+}
+
+static void print_i2c_stats(const char *name, i2c_inst_t *i2c)
+{
+    const mock_i2c_stats_t *s = mock_i2c_get_stats(i2c);
+    printf("%s: %u transacoes, %llu bytes, %u NACKs, %u travamentos, %.3f ms ocupado\n", name,
+           s->transactions, (unsigned long long)s->bytes, s->nacks, s->hangs, s->busy_ns / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t capture_s = 10;
+    const char *image_path = NULL;
+    const char *frames_dir = NULL;
+    const char *snapshot_path = NULL;
+    const char *expect_path = NULL;
+    int64_t fault_s = -1;
+
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--capture-s") && i + 1 < argc) {
+            capture_s = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--image") && i + 1 < argc) {
+            image_path = argv[++i];
+        } else if (!strcmp(argv[i], "--usb-stalled")) {
+            mock_usb_cdc_set_host_reading(false);
+        } else if (!strcmp(argv[i], "--console") && i + 1 < argc) {
+            mock_console_input(argv[++i]);
+        } else if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+            frames_dir = argv[++i];
+        } else if (!strcmp(argv[i], "--snapshot") && i + 1 < argc) {
+            snapshot_path = argv[++i];
+        } else if (!strcmp(argv[i], "--expect") && i + 1 < argc) {
+            expect_path = argv[++i];
+        } else if (!strcmp(argv[i], "--i2c-fault-s") && i + 1 < argc) {
+            fault_s = (int64_t)strtoul(argv[++i], NULL, 10);
+        } else {
+            fprintf(stderr, "uso: %s [--capture-s N] [--image arquivo.img] [--usb-stalled] [--console teclas]\n"
+                            "       [--frames dir] [--snapshot arquivo.pbm] [--expect arquivo.pbm]\n"
+                            "       [--i2c-fault-s N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    mock_mpu6050_attach(MPU_6050_I2C_PORT, NULL, NULL);
+    mock_bmp280_attach(BMP280_I2C_PORT);
+    mock_aht20_attach(AHT20_I2C_PORT);
+    mock_hcsr04_attach(ULTRASONIC_TRIG_PIN, ULTRASONIC_ECHO_PIN);
+    mock_ssd1306_attach(SSD1306_I2C_PORT, SSD1306_ADDRESS);
+    if (frames_dir)
+        mock_ssd1306_on_frame(save_frame, (void *)frames_dir);
+    if (!mock_sd_card_create(HOST_SD_SECTORS) || !mock_sd_card_format())
+        return 1;
+
+    // run_mount() usa strtok(NULL, ...) sem chamada anterior; a glibc exige
+    // um estado inicial válido
+    static char strtok_seed[] = "";
+    strtok(strtok_seed, " ");
+
+    uint64_t t_start = 2000000;
+    uint64_t t_stop = t_start + (uint64_t)capture_s * 1000000ull;
+    mock_gpio_schedule_irq(1000000, BTN_A_PIN, GPIO_IRQ_EDGE_FALL);
+    mock_gpio_schedule_irq(t_start, BTN_B_PIN, GPIO_IRQ_EDGE_FALL);
+    mock_gpio_schedule_irq(t_stop, BTN_B_PIN, GPIO_IRQ_EDGE_FALL);
+    mock_clock_set_deadline(t_stop + 5000000ull, on_deadline);
+    if (fault_s >= 0) {
+        const i2c_bus_t *bus = i2c_bus_of(MPU_6050_I2C_PORT);
+        mock_i2c_hang(bus->hw_inst, t_start + (uint64_t)fault_s * 1000000ull, bus->sda_gpio, bus->scl_gpio);
+    }
+
+    if (!setjmp(sim_end))
+        datalogger_main();
+    mock_ssd1306_end_frame();
+
+    const mock_sd_stats_t *sd = mock_sd_get_stats();
+    const mock_ssd1306_stats_t *oled = mock_ssd1306_get_stats();
+
+    printf("\n==== Resumo da simulacao ====\n");
+    printf("Tempo virtual: %.3f s\n", time_us_64() / 1e6);
+    printf("Amostras lidas do MPU6050: %u\n", mock_mpu6050_samples_served());
+    printf("Conversoes do BMP280: %u, medicoes do AHT20: %u, pulsos do HC-SR04: %u\n",
+           mock_bmp280_conversions(), mock_aht20_measurements(), mock_hcsr04_pings());
+    print_i2c_stats("i2c0", i2c0);
+    print_i2c_stats("i2c1", i2c1);
+    printf("SSD1306: %u bytes de comando, %u bytes de dados em %u escritas\n",
+           oled->command_bytes, oled->data_bytes, oled->data_writes);
+    printf("SSD1306: %u quadros, %.1f bytes/quadro em media, maximo %u, ultimo %u\n",
+           oled->frames, oled->frames ? (double)oled->frame_bytes / oled->frames : 0.0,
+           oled->max_frame_bytes, oled->last_frame_bytes);
+    printf("SD: %u leituras (%llu setores), %u escritas (%llu setores), %.3f ms ocupado\n",
+           sd->read_cmds, (unsigned long long)sd->sectors_read, sd->write_cmds,
+           (unsigned long long)sd->sectors_written, sd->busy_ns / 1e6);
+
+    live_stream_print_stats();
+    trace_dump();
+
+    if (image_path && !mock_sd_save_image(image_path)) {
+        fprintf(stderr, "Falha ao salvar a imagem do SD em %s\n", image_path);
+        return 1;
+    }
+    if (snapshot_path && !mock_ssd1306_save_pbm(snapshot_path)) {
+        fprintf(stderr, "Falha ao salvar o snapshot do display em %s\n", snapshot_path);
+        return 1;
+    }
+    if (expect_path) {
+        int diff = mock_ssd1306_compare_pbm(expect_path);
+        if (diff < 0) {
+            fprintf(stderr, "Referencia %s ausente ou de outro tamanho\n", expect_path);
+            return 3;
+        }
+        if (diff > 0) {
+            fprintf(stderr, "Display difere de %s em %d pixels\n", expect_path, diff);
+            return 3;
+        }
+    }
+    return 0;
+}
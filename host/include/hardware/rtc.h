@@ -0,0 +1,12 @@
+#ifndef HOST_HARDWARE_RTC_H
+#define HOST_HARDWARE_RTC_H
+
+#include "pico/types.h"
+
+// RTC simulado a partir do relógio virtual.
+void rtc_init(void);
+bool rtc_set_datetime(datetime_t *t);
+bool rtc_get_datetime(datetime_t *t);
+bool rtc_running(void);
+
+#endif // HOST_HARDWARE_RTC_H
@@ -0,0 +1,18 @@
+#ifndef HOST_HARDWARE_SPI_H
+#define HOST_HARDWARE_SPI_H
+
+#include "pico/types.h"
+
+// Só o suficiente para que sd_driver/spi.h e config/hw_config.c compilem:
+// o cartão SD simulado (mock_sd_card.c) não passa pelo driver SPI real.
+typedef struct spi_inst {
+    uint index;
+} spi_inst_t;
+
+extern spi_inst_t spi0_inst;
+extern spi_inst_t spi1_inst;
+
+#define spi0 (&spi0_inst)
+#define spi1 (&spi1_inst)
+
+#endif // HOST_HARDWARE_SPI_H
@@ -0,0 +1,13 @@
+#ifndef HOST_HARDWARE_STRUCTS_SCB_H
+#define HOST_HARDWARE_STRUCTS_SCB_H
+
+#include "pico/types.h"
+
+typedef struct {
+    volatile uint32_t aircr;
+} armv6m_scb_hw_t;
+
+extern armv6m_scb_hw_t host_scb;
+#define scb_hw (&host_scb)
+
+#endif // HOST_HARDWARE_STRUCTS_SCB_H
@@ -0,0 +1,6 @@
+#ifndef HOST_HARDWARE_TIMER_H
+#define HOST_HARDWARE_TIMER_H
+
+#include "pico/time.h"
+
+#endif // HOST_HARDWARE_TIMER_H
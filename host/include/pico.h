@@ -0,0 +1,17 @@
+#ifndef HOST_PICO_H
+#define HOST_PICO_H
+
+// Substitui o "pico.h" do SDK no build host: apenas as macros de plataforma
+// usadas pelo projeto e pelas bibliotecas em lib/.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define _u(x) x##u
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __unused __attribute__((unused))
+
+#endif // HOST_PICO_H
@@ -0,0 +1,8 @@
+#ifndef HOST_PICO_BINARY_INFO_H
+#define HOST_PICO_BINARY_INFO_H
+
+// Metadados do picotool não existem no build host.
+#define bi_decl(...)
+#define bi_2pins_with_func(...)
+
+#endif // HOST_PICO_BINARY_INFO_H
@@ -0,0 +1,20 @@
+#ifndef HOST_PICO_MUTEX_H
+#define HOST_PICO_MUTEX_H
+
+#include "pico/types.h"
+
+// O build host é de núcleo único e sem preempção: os mutexes são apenas
+// marcadores de estado.
+typedef struct {
+    bool initialized;
+    bool locked;
+} mutex_t;
+
+#define auto_init_mutex(name) static mutex_t name = {true, false}
+
+static inline void mutex_init(mutex_t *mtx) { mtx->initialized = true; mtx->locked = false; }
+static inline bool mutex_is_initialized(mutex_t *mtx) { return mtx->initialized; }
+static inline void mutex_enter_blocking(mutex_t *mtx) { mtx->locked = true; }
+static inline void mutex_exit(mutex_t *mtx) { mtx->locked = false; }
+
+#endif // HOST_PICO_MUTEX_H
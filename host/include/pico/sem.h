@@ -0,0 +1,16 @@
+#ifndef HOST_PICO_SEM_H
+#define HOST_PICO_SEM_H
+
+#include "pico/types.h"
+
+typedef struct {
+    int16_t permits;
+    int16_t max_permits;
+} semaphore_t;
+
+static inline void sem_init(semaphore_t *sem, int16_t initial, int16_t max) {
+    sem->permits = initial;
+    sem->max_permits = max;
+}
+
+#endif // HOST_PICO_SEM_H
@@ -0,0 +1,18 @@
+#ifndef HOST_PICO_STDIO_H
+#define HOST_PICO_STDIO_H
+
+#include <stdio.h>
+#include "pico/types.h"
+#include "pico/error.h"
+
+// No host o stdio USB é a saída padrão do processo.
+bool stdio_init_all(void);
+
+// Saída pelo stdio USB, como no SDK: os bytes vão para o FIFO do CDC e são
+// entregues no flush (newline e cr_translation são ignorados)
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation);
+
+// Não há entrada interativa na simulação: sempre PICO_ERROR_TIMEOUT
+int getchar_timeout_us(uint32_t timeout_us);
+
+#endif // HOST_PICO_STDIO_H
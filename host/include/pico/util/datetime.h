@@ -0,0 +1,6 @@
+#ifndef HOST_PICO_UTIL_DATETIME_H
+#define HOST_PICO_UTIL_DATETIME_H
+
+#include "pico/types.h"
+
+#endif // HOST_PICO_UTIL_DATETIME_H
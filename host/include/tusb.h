@@ -0,0 +1,15 @@
+#ifndef HOST_TUSB_H
+#define HOST_TUSB_H
+
+#include "pico/types.h"
+
+// Subconjunto da API CDC do TinyUSB. O FIFO de transmissão simulado tem o
+// tamanho do FIFO do stdio USB; ver mock_usb_cdc_set_host_reading().
+#define CFG_TUD_CDC_TX_BUFSIZE 256
+
+bool tud_cdc_connected(void);
+uint32_t tud_cdc_write_available(void);
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize);
+uint32_t tud_cdc_write_flush(void);
+
+#endif // HOST_TUSB_H
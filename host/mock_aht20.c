@@ -0,0 +1,100 @@
+// Modelo do AHT20 (endereço 0x38): comandos de inicialização, medição e reset
+// e resposta de estado + 5 bytes de dados + CRC8.
+
+#include <math.h>
+#include <string.h>
+
+#include "mock_hal.h"
+
+#define AHT20_ADDR 0x38
+#define MEASUREMENT_NS 80000000ull
+
+static mock_i2c_device_t aht;
+static bool calibrated;
+static bool measuring;
+static uint64_t measure_start_ns;
+static uint8_t response[7];
+static uint32_t measurements;
+
+// CRC8 do AHT20: polinômio 0x31, valor inicial 0xFF
+static uint8_t crc8(const uint8_t *data, size_t len)
+{
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; ++b)
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
+    }
+    return crc;
+}
+
+// Umidade e temperatura sintéticas (55 %UR e 24 °C com variação lenta)
+static void make_sample(void)
+{
+    float phase = (float)measurements++ * 0.2f;
+    float humidity = 55.0f + 5.0f * sinf(phase);
+    float temperature = 24.0f + 1.0f * cosf(phase);
+    uint32_t h = (uint32_t)(humidity / 100.0f * 1048576.0f);
+    uint32_t t = (uint32_t)((temperature + 50.0f) / 200.0f * 1048576.0f);
+
+    response[1] = (uint8_t)(h >> 12);
+    response[2] = (uint8_t)(h >> 4);
+    response[3] = (uint8_t)(((h & 0x0F) << 4) | ((t >> 16) & 0x0F));
+    response[4] = (uint8_t)(t >> 8);
+    response[5] = (uint8_t)t;
+}
+
+static int aht_write(mock_i2c_device_t *dev, const uint8_t *src, size_t len, bool nostop)
+{
+    (void)dev;
+    (void)nostop;
+
+    if (len == 0)
+        return 0;
+    if (src[0] == 0xBE) {
+        calibrated = true;
+    } else if (src[0] == 0xAC) {
+        measuring = true;
+        measure_start_ns = mock_clock_now_ns();
+        make_sample();
+    } else if (src[0] == 0xBA) {
+        measuring = false;
+    }
+    return (int)len;
+}
+
+static int aht_read(mock_i2c_device_t *dev, uint8_t *dst, size_t len, bool nostop)
+{
+    (void)dev;
+    (void)nostop;
+
+    bool busy = measuring && mock_clock_now_ns() - measure_start_ns < MEASUREMENT_NS;
+    response[0] = (uint8_t)((busy ? 0x80 : 0x00) | (calibrated ? 0x08 : 0x00) | 0x10);
+    response[6] = crc8(response, 6);
+
+    for (size_t i = 0; i < len; ++i)
+        dst[i] = i < sizeof(response) ? response[i] : 0xFF;
+    return (int)len;
+}
+
+void mock_aht20_attach(i2c_inst_t *i2c)
+{
+    mock_i2c_device_t *next = aht.next; // Preserva a lista se já estiver ligado
+
+    memset(&aht, 0, sizeof(aht));
+    aht.next = next;
+    aht.address = AHT20_ADDR;
+    aht.write = aht_write;
+    aht.read = aht_read;
+    calibrated = false;
+    measuring = false;
+    measurements = 0;
+    memset(response, 0, sizeof(response));
+
+    mock_i2c_attach(i2c, &aht);
+}
+
+uint32_t mock_aht20_measurements(void)
+{
+    return measurements;
+}
@@ -0,0 +1,107 @@
+// Modelo de registradores do BMP280 (endereço 0x77): modos sleep, forçado e
+// normal, com o bit "measuring" do status durante a conversão.
+
+#include <math.h>
+
+#include "mock_hal.h"
+
+#define BMP280_ADDR 0x77
+#define REG_CALIB 0x88
+#define REG_CHIP_ID 0xD0
+#define REG_RESET 0xE0
+#define REG_STATUS 0xF3
+#define REG_CTRL_MEAS 0xF4
+#define REG_CONFIG 0xF5
+#define REG_PRESS_MSB 0xF7
+
+#define STATUS_MEASURING 0x08
+
+static mock_i2c_regfile_t bmp;
+static uint32_t conversions;
+static bool measuring;
+static uint64_t conversion_end_ns;
+
+// Calibração e leituras cruas do exemplo de compensação do datasheet
+// (adc_T = 519888 -> 25,08 °C; adc_P = 415148 -> 100653 Pa)
+static const uint16_t calib[12] = {
+    27504, 26435, (uint16_t)-1000,
+    36477, (uint16_t)-10685, 3024, 2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000,
+};
+
+// Valor de 20 bits em MSB, LSB e XLSB[7:4]
+static void put_adc20(uint8_t *dst, int32_t value)
+{
+    dst[0] = (uint8_t)(value >> 12);
+    dst[1] = (uint8_t)(value >> 4);
+    dst[2] = (uint8_t)((value & 0x0F) << 4);
+}
+
+// Tempo máximo de conversão do datasheet: 1,25 ms + 2,3 ms por passo de
+// sobreamostragem (+ 0,575 ms com pressão)
+static uint64_t conversion_ns(uint8_t ctrl_meas)
+{
+    static const uint8_t steps[8] = {0, 1, 2, 4, 8, 16, 16, 16};
+    uint8_t t = steps[ctrl_meas >> 5], p = steps[(ctrl_meas >> 2) & 0x07];
+
+    return 1250000ull + 2300000ull * (t + p) + (p ? 575000ull : 0);
+}
+
+// Nova amostra com variação lenta
+static void convert(void)
+{
+    float phase = (float)conversions++ * 0.05f;
+    put_adc20(&bmp.regs[REG_PRESS_MSB], 415148 + (int32_t)(400.0f * sinf(phase)));
+    put_adc20(&bmp.regs[REG_PRESS_MSB + 3], 519888 + (int32_t)(2000.0f * cosf(phase)));
+}
+
+// Conclui a conversão forçada em andamento; no modo normal os registradores de
+// dados seguem a conversão contínua e mudam a cada leitura
+static void bmp_on_read(mock_i2c_regfile_t *rf, uint8_t reg)
+{
+    uint8_t mode = rf->regs[REG_CTRL_MEAS] & 0x03;
+
+    if (measuring && mock_clock_now_ns() >= conversion_end_ns) {
+        measuring = false;
+        convert();
+        rf->regs[REG_CTRL_MEAS] &= 0xFC;  // Volta ao modo sleep
+    } else if (mode == 0x03 && reg <= REG_PRESS_MSB) {
+        convert();
+    }
+    rf->regs[REG_STATUS] = measuring ? STATUS_MEASURING : 0;
+}
+
+static void bmp_on_write(mock_i2c_regfile_t *rf, uint8_t reg, uint8_t value)
+{
+    if (reg == REG_CTRL_MEAS && (value & 0x03) != 0x00 && (value & 0x03) != 0x03) {
+        measuring = true;
+        conversion_end_ns = mock_clock_now_ns() + conversion_ns(value);
+    } else if (reg == REG_RESET && value == 0xB6) {
+        rf->regs[REG_CTRL_MEAS] = 0;
+        rf->regs[REG_CONFIG] = 0;
+        rf->regs[REG_RESET] = 0;
+        measuring = false;
+    }
+}
+
+void mock_bmp280_attach(i2c_inst_t *i2c)
+{
+    mock_i2c_regfile_init(&bmp, BMP280_ADDR);
+    bmp.regs[REG_CHIP_ID] = 0x58;
+    for (int i = 0; i < 12; ++i) {
+        bmp.regs[REG_CALIB + 2 * i] = (uint8_t)calib[i];
+        bmp.regs[REG_CALIB + 2 * i + 1] = (uint8_t)(calib[i] >> 8);
+    }
+    put_adc20(&bmp.regs[REG_PRESS_MSB], 415148);
+    put_adc20(&bmp.regs[REG_PRESS_MSB + 3], 519888);
+    bmp.on_read = bmp_on_read;
+    bmp.on_write = bmp_on_write;
+    conversions = 0;
+    measuring = false;
+
+    mock_i2c_attach(i2c, &bmp.dev);
+}
+
+uint32_t mock_bmp280_conversions(void)
+{
+    return conversions;
+}
@@ -0,0 +1,123 @@
+// Canais de DMA simulados. Transferências de 16 bits para IC_DATA_CMD de um
+// I2C ocupam o barramento pelo tempo de envio sem parar a CPU, e leituras de
+// IC_DATA_CMD terminam quando o barramento entrega o último byte pedido;
+// qualquer outro destino é copiado imediatamente.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hardware/dma.h"
+#include "mock_hal.h"
+
+typedef struct {
+    bool claimed;
+    uint64_t busy_until_ns;
+    i2c_inst_t *rx_i2c;        // Recepção de I2C: o fim depende do barramento
+} mock_dma_channel_t;
+
+static mock_dma_channel_t channels[NUM_DMA_CHANNELS];
+
+int dma_claim_unused_channel(bool required)
+{
+    for (uint i = 0; i < NUM_DMA_CHANNELS; ++i) {
+        if (!channels[i].claimed) {
+            channels[i].claimed = true;
+            channels[i].busy_until_ns = 0;
+            channels[i].rx_i2c = NULL;
+            return (int)i;
+        }
+    }
+    if (required) {
+        fprintf(stderr, "Nenhum canal de DMA livre\n");
+        abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel)
+{
+    channels[channel].claimed = false;
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel)
+{
+    (void)channel;
+    dma_channel_config c = {
+        .size = DMA_SIZE_32,
+        .read_increment = true,
+        .write_increment = false,
+        .dreq = 0x3F,  // DREQ_FORCE
+    };
+    return c;
+}
+
+static void copy_now(const dma_channel_config *c, volatile void *write_addr,
+                     const volatile void *read_addr, uint count)
+{
+    size_t size = 1u << c->size;
+    volatile uint8_t *dst = write_addr;
+    const volatile uint8_t *src = read_addr;
+
+    for (uint i = 0; i < count; ++i) {
+        memcpy((void *)dst, (const void *)src, size);
+        if (c->write_increment)
+            dst += size;
+        if (c->read_increment)
+            src += size;
+    }
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config *config, volatile void *write_addr,
+                           const volatile void *read_addr, uint transfer_count, bool trigger)
+{
+    if (!trigger)
+        return;
+
+    channels[channel].rx_i2c = NULL;
+    i2c_inst_t *i2c = mock_i2c_from_data_cmd(read_addr);
+    if (i2c && !config->read_increment) {
+        mock_i2c_arm_rx(i2c, write_addr, transfer_count);
+        channels[channel].rx_i2c = i2c;
+        return;
+    }
+
+    i2c = mock_i2c_from_data_cmd(write_addr);
+    if (i2c && config->size == DMA_SIZE_16 && config->read_increment) {
+        channels[channel].busy_until_ns =
+            mock_i2c_run_data_cmd(i2c, (const uint16_t *)read_addr, transfer_count);
+        return;
+    }
+
+    copy_now(config, write_addr, read_addr, transfer_count);
+    channels[channel].busy_until_ns = mock_clock_now_ns();
+}
+
+static uint64_t busy_until(uint channel)
+{
+    if (channels[channel].rx_i2c)
+        return mock_i2c_rx_done_ns(channels[channel].rx_i2c);
+    return channels[channel].busy_until_ns;
+}
+
+bool dma_channel_is_busy(uint channel)
+{
+    return mock_clock_now_ns() < busy_until(channel);
+}
+
+// Uma recepção que nunca termina (abort no barramento) travaria o RP2040; aqui
+// a espera só retorna
+void dma_channel_wait_for_finish_blocking(uint channel)
+{
+    uint64_t now = mock_clock_now_ns(), until = busy_until(channel);
+    if (now < until && until != UINT64_MAX)
+        mock_clock_advance_ns(until - now);
+}
+
+void dma_channel_abort(uint channel)
+{
+    if (channels[channel].rx_i2c)
+        mock_i2c_arm_rx(channels[channel].rx_i2c, NULL, 0);
+    channels[channel].rx_i2c = NULL;
+    channels[channel].busy_until_ns = 0;
+}
@@ -0,0 +1,413 @@
+// HAL simulada: relógio virtual, GPIO/IRQ, PWM, clocks, RTC e stdio.
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "pico/bootrom.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include "hardware/rtc.h"
+#include "hardware/clocks.h"
+#include "hardware/pwm.h"
+#include "hardware/spi.h"
+#include "hardware/structs/scb.h"
+#include "mock_hal.h"
+
+#define MOCK_MAX_EVENTS 32
+
+typedef struct {
+    uint64_t at_ns;
+    uint gpio;
+    uint32_t events;
+} mock_event_t;
+
+static uint64_t now_ns = 0;
+static uint64_t deadline_ns = UINT64_MAX;
+static void (*deadline_cb)(void) = NULL;
+
+static mock_event_t events[MOCK_MAX_EVENTS];
+static size_t num_events = 0;
+
+static bool gpio_level[NUM_BANK0_GPIOS];
+static uint32_t gpio_irq_mask[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t gpio_callback = NULL;
+static void (*gpio_raw_handler[NUM_BANK0_GPIOS])(void);
+static uint32_t gpio_irq_pending[NUM_BANK0_GPIOS];
+static mock_gpio_output_hook_t gpio_output_hook[NUM_BANK0_GPIOS];
+static void *gpio_output_ctx[NUM_BANK0_GPIOS];
+static mock_gpio_input_hook_t gpio_input_hook[NUM_BANK0_GPIOS];
+static void *gpio_input_ctx[NUM_BANK0_GPIOS];
+
+spi_inst_t spi0_inst = {0};
+spi_inst_t spi1_inst = {1};
+armv6m_scb_hw_t host_scb;
+
+// ---------------------------------------------------------------------------
+// Relógio virtual
+// ---------------------------------------------------------------------------
+
+// Remove e retorna o evento mais antigo com horário <= limit_ns
+static bool pop_event(uint64_t limit_ns, mock_event_t *out)
+{
+    size_t best = num_events;
+    for (size_t i = 0; i < num_events; ++i) {
+        if (events[i].at_ns <= limit_ns && (best == num_events || events[i].at_ns < events[best].at_ns))
+            best = i;
+    }
+    if (best == num_events)
+        return false;
+
+    *out = events[best];
+    events[best] = events[--num_events];
+    return true;
+}
+
+uint64_t mock_clock_now_ns(void)
+{
+    return now_ns;
+}
+
+void mock_clock_advance_ns(uint64_t ns)
+{
+    uint64_t target = now_ns + ns;
+    mock_event_t ev;
+
+    while (pop_event(target, &ev)) {
+        if (ev.at_ns > now_ns)
+            now_ns = ev.at_ns;
+        mock_gpio_inject_irq(ev.gpio, ev.events);
+    }
+    now_ns = target;
+}
+
+void mock_clock_set_deadline(uint64_t at_us, void (*cb)(void))
+{
+    deadline_ns = at_us * 1000ull;
+    deadline_cb = cb;
+}
+
+uint64_t time_us_64(void)
+{
+    return now_ns / 1000ull;
+}
+
+uint32_t time_us_32(void)
+{
+    return (uint32_t)(now_ns / 1000ull);
+}
+
+void sleep_us(uint64_t us)
+{
+    mock_clock_advance_ns(us * 1000ull);
+    if (now_ns >= deadline_ns && deadline_cb) {
+        void (*cb)(void) = deadline_cb;
+        deadline_cb = NULL;
+        cb();
+    }
+}
+
+void sleep_ms(uint32_t ms)
+{
+    sleep_us((uint64_t)ms * 1000ull);
+}
+
+void sleep_until(absolute_time_t t)
+{
+    uint64_t now = time_us_64();
+    if (t > now)
+        sleep_us(t - now);
+}
+
+void busy_wait_us(uint64_t us)
+{
+    mock_clock_advance_ns(us * 1000ull);
+}
+
+void busy_wait_ms(uint32_t ms)
+{
+    busy_wait_us((uint64_t)ms * 1000ull);
+}
+
+// Cada volta de um laço de espera custa 1 us, para que esperas ativas terminem
+void tight_loop_contents(void)
+{
+    mock_clock_advance_ns(1000);
+}
+
+// ---------------------------------------------------------------------------
+// GPIO e interrupções
+// ---------------------------------------------------------------------------
+
+void gpio_init(uint gpio) { gpio_level[gpio] = false; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_put(uint gpio, bool value)
+{
+    bool old = gpio_level[gpio];
+    gpio_level[gpio] = value;
+    if (gpio_output_hook[gpio] && old != value)
+        gpio_output_hook[gpio](gpio, value, gpio_output_ctx[gpio]);
+}
+
+bool gpio_get(uint gpio)
+{
+    if (gpio_input_hook[gpio])
+        return gpio_input_hook[gpio](gpio, gpio_input_ctx[gpio]);
+    return gpio_level[gpio];
+}
+void gpio_pull_up(uint gpio) { gpio_level[gpio] = true; }
+void gpio_pull_down(uint gpio) { gpio_level[gpio] = false; }
+void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+void gpio_set_drive_strength(uint gpio, enum gpio_drive_strength drive) { (void)gpio; (void)drive; }
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled)
+{
+    if (enabled)
+        gpio_irq_mask[gpio] |= event_mask;
+    else
+        gpio_irq_mask[gpio] &= ~event_mask;
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback)
+{
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    if (enabled)
+        gpio_callback = callback;
+}
+
+void gpio_add_raw_irq_handler(uint gpio, void (*handler)(void))
+{
+    gpio_raw_handler[gpio] = handler;
+}
+
+uint32_t gpio_get_irq_event_mask(uint gpio)
+{
+    return gpio_irq_pending[gpio];
+}
+
+void gpio_acknowledge_irq(uint gpio, uint32_t event_mask)
+{
+    gpio_irq_pending[gpio] &= ~event_mask;
+}
+
+void mock_gpio_set_level(uint gpio, bool value)
+{
+    gpio_level[gpio] = value;
+}
+
+void mock_gpio_set_output_hook(uint gpio, mock_gpio_output_hook_t hook, void *ctx)
+{
+    gpio_output_hook[gpio] = hook;
+    gpio_output_ctx[gpio] = ctx;
+}
+
+void mock_gpio_set_input_hook(uint gpio, mock_gpio_input_hook_t hook, void *ctx)
+{
+    gpio_input_hook[gpio] = hook;
+    gpio_input_ctx[gpio] = ctx;
+}
+
+void mock_gpio_inject_irq(uint gpio, uint32_t events_mask)
+{
+    if (events_mask & GPIO_IRQ_EDGE_FALL)
+        gpio_level[gpio] = false;
+    if (events_mask & GPIO_IRQ_EDGE_RISE)
+        gpio_level[gpio] = true;
+
+    gpio_irq_pending[gpio] |= events_mask & gpio_irq_mask[gpio];
+    if (gpio_irq_pending[gpio] && gpio_raw_handler[gpio])
+        gpio_raw_handler[gpio]();
+
+    // O que o tratador raw não reconheceu segue para o callback
+    uint32_t pending = gpio_irq_pending[gpio];
+    gpio_irq_pending[gpio] = 0;
+    if (pending && gpio_callback)
+        gpio_callback(gpio, pending);
+}
+
+bool mock_gpio_schedule_irq(uint64_t at_us, uint gpio, uint32_t events_mask)
+{
+    if (num_events >= MOCK_MAX_EVENTS)
+        return false;
+    events[num_events++] = (mock_event_t){at_us * 1000ull, gpio, events_mask};
+    return true;
+}
+
+void irq_set_enabled(uint num, bool enabled) { (void)num; (void)enabled; }
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) { (void)num; (void)handler; }
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority)
+{
+    (void)num; (void)handler; (void)order_priority;
+}
+
+uint32_t save_and_disable_interrupts(void) { return 0; }
+void restore_interrupts(uint32_t status) { (void)status; }
+
+// ---------------------------------------------------------------------------
+// PWM, clocks, stdio e bootrom
+// ---------------------------------------------------------------------------
+
+void pwm_init(uint slice_num, pwm_config *c, bool start) { (void)slice_num; (void)c; (void)start; }
+void pwm_set_wrap(uint slice_num, uint16_t wrap) { (void)slice_num; (void)wrap; }
+void pwm_set_gpio_level(uint gpio, uint16_t level) { (void)gpio; (void)level; }
+void pwm_set_enabled(uint slice_num, bool enabled) { (void)slice_num; (void)enabled; }
+
+uint32_t clock_get_hz(enum clock_index clk_index)
+{
+    return clk_index == clk_usb || clk_index == clk_adc ? 48000000u : 125000000u;
+}
+
+bool stdio_init_all(void)
+{
+    return true;
+}
+
+// USB CDC: com o terminal lendo, cada flush esvazia o FIFO para o stdout
+static bool cdc_host_reading = true;
+static uint8_t cdc_fifo[CFG_TUD_CDC_TX_BUFSIZE];
+static uint32_t cdc_fifo_len = 0;
+
+void mock_usb_cdc_set_host_reading(bool reading)
+{
+    cdc_host_reading = reading;
+}
+
+bool tud_cdc_connected(void)
+{
+    return true;
+}
+
+uint32_t tud_cdc_write_available(void)
+{
+    return CFG_TUD_CDC_TX_BUFSIZE - cdc_fifo_len;
+}
+
+uint32_t tud_cdc_write(const void *buffer, uint32_t bufsize)
+{
+    uint32_t n = bufsize < tud_cdc_write_available() ? bufsize : tud_cdc_write_available();
+    memcpy(&cdc_fifo[cdc_fifo_len], buffer, n);
+    cdc_fifo_len += n;
+    return n;
+}
+
+uint32_t tud_cdc_write_flush(void)
+{
+    if (!cdc_host_reading)
+        return 0;
+    uint32_t n = cdc_fifo_len;
+    fwrite(cdc_fifo, 1, n, stdout);
+    cdc_fifo_len = 0;
+    return n;
+}
+
+int stdio_put_string(const char *s, int len, bool newline, bool cr_translation)
+{
+    (void)newline;
+    (void)cr_translation;
+    uint32_t n = tud_cdc_write(s, (uint32_t)len);
+    tud_cdc_write_flush();
+    return (int)n;
+}
+
+static char console_keys[64];
+static size_t console_head = 0, console_len = 0;
+
+void mock_console_input(const char *keys)
+{
+    size_t n = strlen(keys);
+    if (n > sizeof(console_keys) - 1)
+        n = sizeof(console_keys) - 1;
+    memcpy(console_keys, keys, n);
+    console_head = 0;
+    console_len = n;
+}
+
+int getchar_timeout_us(uint32_t timeout_us)
+{
+    (void)timeout_us;
+    if (console_head == console_len)
+        return PICO_ERROR_TIMEOUT;
+    return (unsigned char)console_keys[console_head++];
+}
+
+void reset_usb_boot(uint32_t usb_activity_gpio_pin_mask, uint32_t disable_interface_mask)
+{
+    (void)usb_activity_gpio_pin_mask;
+    (void)disable_interface_mask;
+    fprintf(stderr, "reset_usb_boot() chamado no build host\n");
+}
+
+// ---------------------------------------------------------------------------
+// RTC: data/hora definida + tempo virtual decorrido
+// ---------------------------------------------------------------------------
+
+static bool rtc_is_set = false;
+static time_t rtc_base_epoch;
+static uint64_t rtc_base_us;
+
+void rtc_init(void) {}
+
+bool rtc_running(void)
+{
+    return rtc_is_set;
+}
+
+bool rtc_set_datetime(datetime_t *t)
+{
+    struct tm tm = {
+        .tm_sec = t->sec,
+        .tm_min = t->min,
+        .tm_hour = t->hour,
+        .tm_mday = t->day,
+        .tm_mon = t->month - 1,
+        .tm_year = t->year - 1900,
+    };
+    rtc_base_epoch = timegm(&tm);
+    rtc_base_us = time_us_64();
+    rtc_is_set = true;
+    return true;
+}
+
+bool rtc_get_datetime(datetime_t *t)
+{
+    if (!rtc_is_set)
+        return false;
+
+    time_t now = rtc_base_epoch + (time_t)((time_us_64() - rtc_base_us) / 1000000ull);
+    struct tm tm;
+    gmtime_r(&now, &tm);
+    t->year = (int16_t)(tm.tm_year + 1900);
+    t->month = (int8_t)(tm.tm_mon + 1);
+    t->day = (int8_t)tm.tm_mday;
+    t->dotw = (int8_t)tm.tm_wday;
+    t->hour = (int8_t)tm.tm_hour;
+    t->min = (int8_t)tm.tm_min;
+    t->sec = (int8_t)tm.tm_sec;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Substitutos de my_debug.c (o original usa instruções ARM)
+// ---------------------------------------------------------------------------
+
+#include <stdarg.h>
+#include <stdlib.h>
+#include "my_debug.h"
+
+void my_printf(const char *pcFormat, ...)
+{
+    va_list xArgs;
+    va_start(xArgs, pcFormat);
+    vprintf(pcFormat, xArgs);
+    va_end(xArgs);
+    fflush(stdout);
+}
+
+void my_assert_func(const char *file, int line, const char *func, const char *pred)
+{
+    fprintf(stderr, "assertion \"%s\" failed: file \"%s\", line %d, function: %s\n",
+            pred, file, line, func);
+    abort();
+}
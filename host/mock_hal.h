@@ -0,0 +1,244 @@
+#ifndef MOCK_HAL_H
+#define MOCK_HAL_H
+
+// API de controle da HAL simulada usada pelo build host (DATALOGGER_HOST_BUILD).
+// O código do datalogger continua chamando a API do Pico SDK normalmente; estas
+// funções servem para o executável host montar o cenário: dispositivos I2C,
+// cartão SD, eventos de GPIO e limite de tempo da simulação.
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/types.h"
+#include "hardware/i2c.h"
+
+// ---------------------------------------------------------------------------
+// Relógio virtual
+// ---------------------------------------------------------------------------
+
+// Instante atual do relógio virtual, em nanossegundos
+uint64_t mock_clock_now_ns(void);
+
+// Avança o relógio virtual (em nanossegundos), disparando os eventos agendados
+void mock_clock_advance_ns(uint64_t ns);
+
+// Agenda o fim da simulação: ao atingir at_us dentro de um sleep_*, cb é chamada
+// (normalmente faz longjmp de volta ao executável host)
+void mock_clock_set_deadline(uint64_t at_us, void (*cb)(void));
+
+// ---------------------------------------------------------------------------
+// GPIO
+// ---------------------------------------------------------------------------
+
+// Força o nível de um pino de entrada (ex.: botão pressionado = false)
+void mock_gpio_set_level(uint gpio, bool value);
+
+// Gera imediatamente uma interrupção de GPIO, como se a borda tivesse ocorrido
+void mock_gpio_inject_irq(uint gpio, uint32_t events);
+
+// Agenda uma interrupção de GPIO para o instante at_us do relógio virtual
+bool mock_gpio_schedule_irq(uint64_t at_us, uint gpio, uint32_t events);
+
+// Modelos ligados a pinos: o hook de saída é chamado a cada mudança de nível
+// escrita pelo firmware; o de entrada fornece o nível lido por gpio_get()
+typedef void (*mock_gpio_output_hook_t)(uint gpio, bool value, void *ctx);
+typedef bool (*mock_gpio_input_hook_t)(uint gpio, void *ctx);
+void mock_gpio_set_output_hook(uint gpio, mock_gpio_output_hook_t hook, void *ctx);
+void mock_gpio_set_input_hook(uint gpio, mock_gpio_input_hook_t hook, void *ctx);
+
+// ---------------------------------------------------------------------------
+// USB CDC
+// ---------------------------------------------------------------------------
+
+// Simula um terminal que parou de ler: o FIFO do CDC enche e não esvazia
+void mock_usb_cdc_set_host_reading(bool reading);
+
+// Teclas digitadas no terminal; getchar_timeout_us() as entrega uma a uma
+void mock_console_input(const char *keys);
+
+// ---------------------------------------------------------------------------
+// Barramento I2C
+// ---------------------------------------------------------------------------
+
+typedef struct mock_i2c_device mock_i2c_device_t;
+
+// Dispositivo escravo ligado a um barramento simulado. write/read retornam o
+// número de bytes aceitos ou PICO_ERROR_GENERIC para NACK.
+struct mock_i2c_device {
+    uint8_t address;
+    int (*write)(mock_i2c_device_t *dev, const uint8_t *src, size_t len, bool nostop);
+    int (*read)(mock_i2c_device_t *dev, uint8_t *dst, size_t len, bool nostop);
+    mock_i2c_device_t *next;
+};
+
+typedef struct {
+    uint32_t transactions;  // Transações (START ... STOP/RESTART)
+    uint32_t nacks;         // Transações sem dispositivo no endereço
+    uint32_t timeouts;      // Transações bloqueantes com o barramento preso
+    uint32_t hangs;         // Falhas injetadas por mock_i2c_hang() que ocorreram
+    uint64_t bytes;         // Bytes de dados trafegados (sem o byte de endereço)
+    uint64_t busy_ns;       // Tempo total de barramento ocupado
+} mock_i2c_stats_t;
+
+void mock_i2c_attach(i2c_inst_t *i2c, mock_i2c_device_t *dev);
+
+// Desliga o dispositivo do barramento: as transações com ele recebem NACK
+void mock_i2c_detach(i2c_inst_t *i2c, mock_i2c_device_t *dev);
+
+// Barramento preso: a partir de at_us um escravo segura SDA em nível baixo
+// (reset ou ruído no meio de um byte). As transações com timeout retornam
+// PICO_ERROR_TIMEOUT após o timeout e as leituras por DMA nunca terminam, até
+// o firmware gerar MOCK_I2C_HANG_PULSES bordas de subida em scl_gpio (com os
+// pinos como GPIO); sda_gpio lê nível baixo enquanto isso.
+#define MOCK_I2C_HANG_PULSES 5
+void mock_i2c_hang(i2c_inst_t *i2c, uint64_t at_us, uint sda_gpio, uint scl_gpio);
+bool mock_i2c_hung(i2c_inst_t *i2c);
+
+// Limita a velocidade que o barramento aguenta (pull-ups fracos, fios longos):
+// acima dela toda transação recebe NACK. 0 remove o limite.
+void mock_i2c_set_max_baudrate(i2c_inst_t *i2c, uint baudrate);
+const mock_i2c_stats_t *mock_i2c_get_stats(i2c_inst_t *i2c);
+void mock_i2c_reset_stats(i2c_inst_t *i2c);
+
+// Dispositivo genérico com banco de 256 registradores e ponteiro com
+// auto-incremento, o modelo usado pela maioria dos sensores I2C.
+typedef struct mock_i2c_regfile mock_i2c_regfile_t;
+struct mock_i2c_regfile {
+    mock_i2c_device_t dev;
+    uint8_t regs[256];
+    uint8_t pointer;
+    void (*on_read)(mock_i2c_regfile_t *rf, uint8_t reg);                 // Antes de uma leitura a partir de reg
+    void (*on_write)(mock_i2c_regfile_t *rf, uint8_t reg, uint8_t value); // Após cada byte escrito
+    void *ctx;
+};
+
+void mock_i2c_regfile_init(mock_i2c_regfile_t *rf, uint8_t address);
+
+// Uso interno do DMA simulado: identifica o I2C dono de um endereço de
+// IC_DATA_CMD e executa as palavras escritas nele, retornando o instante (ns)
+// em que o barramento termina de enviá-las
+i2c_inst_t *mock_i2c_from_data_cmd(const volatile void *addr);
+uint64_t mock_i2c_run_data_cmd(i2c_inst_t *i2c, const uint16_t *words, size_t count);
+
+// Recepção por DMA: arma o destino dos próximos len bytes lidos do barramento
+// (NULL desarma) e informa quando o último chegou
+void mock_i2c_arm_rx(i2c_inst_t *i2c, volatile void *dst, size_t len);
+uint64_t mock_i2c_rx_done_ns(i2c_inst_t *i2c);
+
+// ---------------------------------------------------------------------------
+// Sensores e periféricos simulados
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int16_t accel[3];
+    int16_t gyro[3];
+    int16_t temp;
+} mock_mpu6050_sample_t;
+
+// Fonte de amostras do MPU6050; retorna false quando não há mais dados
+typedef bool (*mock_mpu6050_source_t)(void *ctx, mock_mpu6050_sample_t *out);
+
+// Liga um MPU6050 em 0x68; com source NULL gera um sinal sintético determinístico
+// No modo sleep (estado após energizar) os registradores de dados não mudam.
+void mock_mpu6050_attach(i2c_inst_t *i2c, mock_mpu6050_source_t source, void *ctx);
+uint32_t mock_mpu6050_samples_served(void);
+
+// Desconecta o MPU6050 (NACK em tudo) ou o reconecta como recém-energizado:
+// registradores zerados e em sleep até o firmware escrever PWR_MGMT_1
+void mock_mpu6050_set_connected(bool connected);
+
+// BMP280 em 0x77 com a calibração do exemplo do datasheet (~25 °C, ~1006 hPa,
+// variando lentamente a cada conversão). No modo forçado a conversão leva o
+// tempo máximo do datasheet para a sobreamostragem escolhida, com o bit
+// "measuring" aceso; no modo normal há uma conversão nova a cada leitura.
+void mock_bmp280_attach(i2c_inst_t *i2c);
+uint32_t mock_bmp280_conversions(void);
+
+// AHT20 em 0x38: medição disparada por 0xAC fica pronta após 80 ms; a resposta
+// de 7 bytes traz o CRC8 (polinômio 0x31)
+void mock_aht20_attach(i2c_inst_t *i2c);
+uint32_t mock_aht20_measurements(void);
+
+// HC-SR04: o eco começa 500 us após a descida do gatilho e dura 58 us/cm, com
+// uma distância sintética em torno de 1 m; as bordas do eco geram interrupções
+void mock_hcsr04_attach(uint trig_pin, uint echo_pin);
+uint32_t mock_hcsr04_pings(void);
+
+// Painel virtual: interpreta comandos (endereçamento, janelas, liga/desliga,
+// contraste, inversão, multiplex) e grava os dados numa GDDRAM 128x64, de onde
+// saem os snapshots PBM. Escritas separadas por mais de
+// MOCK_SSD1306_FRAME_GAP_NS formam quadros diferentes.
+#define MOCK_SSD1306_FRAME_GAP_NS 5000000ull
+
+typedef struct {
+    uint32_t command_bytes;  // Bytes enviados com Co/D# = comando (0x00/0x80)
+    uint32_t data_bytes;     // Bytes de GDDRAM enviados com controle 0x40
+    uint32_t data_writes;    // Transações de dados
+    uint32_t frames;         // Quadros com escrita na GDDRAM
+    uint32_t frame_bytes;    // Bytes no barramento somados sobre os quadros
+    uint32_t last_frame_bytes;
+    uint32_t max_frame_bytes;
+} mock_ssd1306_stats_t;
+
+typedef struct {
+    uint32_t commands;       // Comandos completos interpretados
+    uint8_t addressing_mode; // 0 horizontal, 1 vertical, 2 página
+    uint8_t mux_ratio;       // Altura - 1
+    uint8_t start_line;
+    uint8_t contrast;
+    bool display_on;
+    bool inverted;
+    bool entire_on;
+} mock_ssd1306_state_t;
+
+typedef struct {
+    uint32_t index;          // 1, 2, ...
+    uint64_t start_ns;
+    uint32_t transactions;
+    uint32_t bytes;          // Bytes no barramento (controle + comandos + dados)
+    uint32_t data_bytes;     // Bytes de GDDRAM
+} mock_ssd1306_frame_t;
+
+// Chamada ao fim de cada quadro, com a GDDRAM já no estado final do quadro
+typedef void (*mock_ssd1306_frame_cb_t)(const mock_ssd1306_frame_t *frame, void *ctx);
+
+void mock_ssd1306_attach(i2c_inst_t *i2c, uint8_t address);
+const mock_ssd1306_stats_t *mock_ssd1306_get_stats(void);
+void mock_ssd1306_reset_stats(void);
+const mock_ssd1306_state_t *mock_ssd1306_get_state(void);
+
+// Altura configurada (multiplex + 1) e pixel (x, y) da GDDRAM
+uint8_t mock_ssd1306_height(void);
+bool mock_ssd1306_pixel(uint8_t x, uint8_t y);
+
+void mock_ssd1306_on_frame(mock_ssd1306_frame_cb_t cb, void *ctx);
+
+// Fecha o quadro em andamento (ex.: no fim da simulação)
+void mock_ssd1306_end_frame(void);
+
+// Snapshot da GDDRAM em PBM binário (P4)
+bool mock_ssd1306_save_pbm(const char *path);
+
+// Compara a GDDRAM com um PBM de referência: retorna o número de pixels
+// diferentes ou -1 se o arquivo não existir ou tiver outro tamanho
+int mock_ssd1306_compare_pbm(const char *path);
+
+// ---------------------------------------------------------------------------
+// Cartão SD (dispositivo de blocos em RAM com custo de SPI simulado)
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    uint32_t read_cmds;        // CMD17/CMD18
+    uint32_t write_cmds;       // CMD24/CMD25
+    uint64_t sectors_read;
+    uint64_t sectors_written;
+    uint64_t busy_ns;          // Tempo de SPI + programação do cartão
+} mock_sd_stats_t;
+
+bool mock_sd_card_create(uint32_t sectors);
+bool mock_sd_card_format(void);
+bool mock_sd_save_image(const char *path);
+const mock_sd_stats_t *mock_sd_get_stats(void);
+void mock_sd_reset_stats(void);
+
+#endif // MOCK_HAL_H
@@ -0,0 +1,57 @@
+// Modelo do sensor ultrassônico HC-SR04 ligado a dois GPIOs: o nível do eco
+// segue o relógio virtual e as bordas geram interrupções de GPIO.
+
+#include <math.h>
+
+#include "hardware/gpio.h"
+#include "mock_hal.h"
+
+#define ECHO_DELAY_US 500          // Do fim do gatilho ao início do eco
+#define ECHO_US_PER_CM 58.0f       // Ida e volta do som: ~58 us por cm
+
+static uint echo;
+static uint64_t echo_start_ns = UINT64_MAX;
+static uint64_t echo_end_ns = 0;
+static uint32_t pings;
+
+// A descida do gatilho dispara a medição de uma distância sintética
+static void trig_hook(uint gpio, bool value, void *ctx)
+{
+    (void)gpio;
+    (void)ctx;
+
+    if (value)
+        return;
+    float distance_cm = 100.0f + 20.0f * sinf((float)pings++ * 0.3f);
+    uint64_t start_us = mock_clock_now_ns() / 1000ull + ECHO_DELAY_US;
+    uint64_t end_us = start_us + (uint64_t)(distance_cm * ECHO_US_PER_CM);
+
+    echo_start_ns = start_us * 1000ull;
+    echo_end_ns = end_us * 1000ull;
+    mock_gpio_schedule_irq(start_us, echo, GPIO_IRQ_EDGE_RISE);
+    mock_gpio_schedule_irq(end_us, echo, GPIO_IRQ_EDGE_FALL);
+}
+
+static bool echo_hook(uint gpio, void *ctx)
+{
+    (void)gpio;
+    (void)ctx;
+
+    uint64_t now = mock_clock_now_ns();
+    return now >= echo_start_ns && now < echo_end_ns;
+}
+
+void mock_hcsr04_attach(uint trig_pin, uint echo_pin)
+{
+    echo = echo_pin;
+    echo_start_ns = UINT64_MAX;
+    echo_end_ns = 0;
+    pings = 0;
+    mock_gpio_set_output_hook(trig_pin, trig_hook, NULL);
+    mock_gpio_set_input_hook(echo_pin, echo_hook, NULL);
+}
+
+uint32_t mock_hcsr04_pings(void)
+{
+    return pings;
+}
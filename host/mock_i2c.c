@@ -0,0 +1,366 @@
+// Barramentos I2C simulados com custo de tempo proporcional aos bits trafegados.
+
+#include <string.h>
+
+#include "hardware/i2c.h"
+#include "mock_hal.h"
+
+struct i2c_inst {
+    uint index;
+    uint baudrate;
+    uint max_baudrate;       // Acima disso nenhum dispositivo responde (0: sem limite)
+    mock_i2c_device_t *devices;
+    mock_i2c_stats_t stats;
+    i2c_hw_t hw;
+    uint64_t busy_until_ns;  // Fim da transferência por DMA em andamento
+
+    // DMA de recepção armado: destino, bytes pedidos/recebidos e instante em
+    // que o último chega (UINT64_MAX enquanto faltar algum)
+    uint8_t *rx_dst;
+    size_t rx_want, rx_got;
+    uint64_t rx_done_ns;
+
+    // Falha injetada: a partir de hang_at_ns um escravo segura SDA em nível
+    // baixo até receber MOCK_I2C_HANG_PULSES pulsos em SCL
+    uint64_t hang_at_ns;     // 0: sem falha agendada
+    bool hung;
+    uint hang_pulses;
+    uint sda_gpio, scl_gpio;
+};
+
+i2c_inst_t i2c0_inst = {.index = 0};
+i2c_inst_t i2c1_inst = {.index = 1};
+
+static bool bus_hung(i2c_inst_t *i2c)
+{
+    if (i2c->hang_at_ns && mock_clock_now_ns() >= i2c->hang_at_ns) {
+        i2c->hang_at_ns = 0;
+        i2c->hung = true;
+        i2c->hang_pulses = 0;
+        i2c->stats.hangs++;
+    }
+    return i2c->hung;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate)
+{
+    return i2c_set_baudrate(i2c, baudrate);
+}
+
+void i2c_deinit(i2c_inst_t *i2c)
+{
+    i2c->baudrate = 0;
+}
+
+uint i2c_set_baudrate(i2c_inst_t *i2c, uint baudrate)
+{
+    i2c->baudrate = baudrate;
+    return baudrate;
+}
+
+uint i2c_hw_index(i2c_inst_t *i2c)
+{
+    return i2c->index;
+}
+
+i2c_hw_t *i2c_get_hw(i2c_inst_t *i2c)
+{
+    bool active = mock_clock_now_ns() < i2c->busy_until_ns || bus_hung(i2c);
+    i2c->hw.status = active ? I2C_IC_STATUS_ACTIVITY_BITS | I2C_IC_STATUS_TFNF_BITS
+                            : I2C_IC_STATUS_TFE_BITS | I2C_IC_STATUS_TFNF_BITS;
+    return &i2c->hw;
+}
+
+uint i2c_get_dreq(i2c_inst_t *i2c, bool is_tx)
+{
+    // DREQ_I2C0_TX = 32, DREQ_I2C0_RX = 33, DREQ_I2C1_TX = 34, DREQ_I2C1_RX = 35
+    return 32 + 2 * i2c->index + (is_tx ? 0 : 1);
+}
+
+static mock_i2c_device_t *find_device(i2c_inst_t *i2c, uint8_t addr)
+{
+    if (i2c->max_baudrate && i2c->baudrate > i2c->max_baudrate)
+        return NULL;
+    for (mock_i2c_device_t *dev = i2c->devices; dev; dev = dev->next)
+        if (dev->address == addr)
+            return dev;
+    return NULL;
+}
+
+// START + endereço + len bytes, 9 bits cada (dado + ACK), + STOP
+static uint64_t account_transaction(i2c_inst_t *i2c, size_t len)
+{
+    uint baud = i2c->baudrate ? i2c->baudrate : 100000;
+    uint64_t bits = 9ull * (len + 1) + 2;
+    uint64_t ns = bits * 1000000000ull / baud;
+
+    i2c->stats.transactions++;
+    i2c->stats.bytes += len;
+    i2c->stats.busy_ns += ns;
+    return ns;
+}
+
+// Transação bloqueante: espera o fim de um envio por DMA e ocupa a CPU
+static void charge_bus_time(i2c_inst_t *i2c, size_t len)
+{
+    uint64_t now = mock_clock_now_ns();
+    if (now < i2c->busy_until_ns)
+        mock_clock_advance_ns(i2c->busy_until_ns - now);
+    mock_clock_advance_ns(account_transaction(i2c, len));
+}
+
+i2c_inst_t *mock_i2c_from_data_cmd(const volatile void *addr)
+{
+    if (addr == &i2c0_inst.hw.data_cmd)
+        return i2c0;
+    if (addr == &i2c1_inst.hw.data_cmd)
+        return i2c1;
+    return NULL;
+}
+
+// Segmento do fluxo de IC_DATA_CMD: escrita (bytes em txn) ou leitura de
+// nread bytes, entregues ao DMA de recepção armado por mock_i2c_arm_rx()
+static bool run_segment(i2c_inst_t *i2c, uint64_t *t, const uint8_t *txn, size_t len, size_t nread,
+                        bool nostop)
+{
+    mock_i2c_device_t *dev = find_device(i2c, (uint8_t)i2c->hw.tar);
+    if (!dev || (nread ? !dev->read : !dev->write)) {
+        *t += account_transaction(i2c, 0);
+        i2c->stats.nacks++;
+        i2c->hw.raw_intr_stat |= I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+        return false;  // O controlador descarta o resto do FIFO após o abort
+    }
+
+    if (!nread) {
+        *t += account_transaction(i2c, len);
+        dev->write(dev, txn, len, nostop);
+        return true;
+    }
+
+    uint8_t rx[256];
+    if (nread > sizeof(rx))
+        nread = sizeof(rx);
+    *t += account_transaction(i2c, nread);
+    dev->read(dev, rx, nread, nostop);
+
+    // Sem DMA de recepção armado os bytes se perdem (no RP2040 ficariam no FIFO)
+    size_t n = i2c->rx_want - i2c->rx_got;
+    if (n > nread)
+        n = nread;
+    if (i2c->rx_dst && n) {
+        memcpy(i2c->rx_dst + i2c->rx_got, rx, n);
+        i2c->rx_got += n;
+        if (i2c->rx_got == i2c->rx_want)
+            i2c->rx_done_ns = *t;
+    }
+    return true;
+}
+
+// Executa o fluxo de palavras de IC_DATA_CMD escrito pelo DMA. Palavras com o
+// bit CMD pedem um byte de leitura; cada STOP, RESTART ou troca de direção
+// fecha uma transação com hw.tar. Os dados chegam ao dispositivo (e as leituras
+// ao destino do DMA de recepção) na hora, mas o barramento fica ocupado (sem
+// parar a CPU) até o instante retornado.
+uint64_t mock_i2c_run_data_cmd(i2c_inst_t *i2c, const uint16_t *words, size_t count)
+{
+    uint8_t txn[1100];
+    size_t len = 0, nread = 0;
+    uint64_t start = mock_clock_now_ns();
+    uint64_t t = start > i2c->busy_until_ns ? start : i2c->busy_until_ns;
+
+    // Barramento preso: os comandos ficam no FIFO e nenhum byte chega
+    if (bus_hung(i2c))
+        return t;
+
+    i2c->hw.raw_intr_stat &= ~I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS;
+    for (size_t i = 0; i < count; ++i) {
+        bool read = words[i] & I2C_IC_DATA_CMD_CMD_BITS;
+        bool restart = words[i] & I2C_IC_DATA_CMD_RESTART_BITS;
+
+        if ((len || nread) && (restart || read != (nread > 0))) {
+            if (!run_segment(i2c, &t, txn, len, nread, true))
+                break;
+            len = nread = 0;
+        }
+        if (read)
+            nread++;
+        else if (len < sizeof(txn))
+            txn[len++] = (uint8_t)words[i];
+
+        if (!(words[i] & I2C_IC_DATA_CMD_STOP_BITS) && i + 1 < count)
+            continue;
+        if (!run_segment(i2c, &t, txn, len, nread, false))
+            break;
+        len = nread = 0;
+    }
+
+    i2c->busy_until_ns = t;
+    return t;
+}
+
+void mock_i2c_arm_rx(i2c_inst_t *i2c, volatile void *dst, size_t len)
+{
+    i2c->rx_dst = (uint8_t *)dst;
+    i2c->rx_want = dst ? len : 0;
+    i2c->rx_got = 0;
+    i2c->rx_done_ns = dst && len ? UINT64_MAX : 0;
+}
+
+uint64_t mock_i2c_rx_done_ns(i2c_inst_t *i2c)
+{
+    return i2c->rx_done_ns;
+}
+
+// Transação bloqueante; com o barramento preso só retorna no timeout (sem
+// timeout o RP2040 ficaria preso para sempre: aqui retorna após 1 s)
+static int transfer(i2c_inst_t *i2c, uint8_t addr, uint8_t *buf, size_t len, bool nostop, bool read,
+                    uint timeout_us)
+{
+    if (bus_hung(i2c)) {
+        mock_clock_advance_ns((uint64_t)(timeout_us ? timeout_us : 1000000u) * 1000u);
+        i2c->stats.timeouts++;
+        return PICO_ERROR_TIMEOUT;
+    }
+
+    mock_i2c_device_t *dev = find_device(i2c, addr);
+    if (!dev || (read ? !dev->read : !dev->write)) {
+        charge_bus_time(i2c, 0);
+        i2c->stats.nacks++;
+        return PICO_ERROR_GENERIC;
+    }
+    charge_bus_time(i2c, len);
+    return read ? dev->read(dev, buf, len, nostop) : dev->write(dev, buf, len, nostop);
+}
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return transfer(i2c, addr, (uint8_t *)src, len, nostop, false, 0);
+}
+
+int i2c_read_blocking(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return transfer(i2c, addr, dst, len, nostop, true, 0);
+}
+
+int i2c_write_timeout_us(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop, uint timeout_us)
+{
+    return transfer(i2c, addr, (uint8_t *)src, len, nostop, false, timeout_us);
+}
+
+int i2c_read_timeout_us(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop, uint timeout_us)
+{
+    return transfer(i2c, addr, dst, len, nostop, true, timeout_us);
+}
+
+void mock_i2c_attach(i2c_inst_t *i2c, mock_i2c_device_t *dev)
+{
+    for (mock_i2c_device_t *it = i2c->devices; it; it = it->next)
+        if (it == dev)
+            return; // Já ligado (benchmarks reutilizam os modelos estáticos)
+
+    dev->next = i2c->devices;
+    i2c->devices = dev;
+}
+
+void mock_i2c_detach(i2c_inst_t *i2c, mock_i2c_device_t *dev)
+{
+    for (mock_i2c_device_t **it = &i2c->devices; *it; it = &(*it)->next) {
+        if (*it == dev) {
+            *it = dev->next;
+            dev->next = NULL;
+            return;
+        }
+    }
+}
+
+// SDA preso lê nível baixo; solto, o pull-up
+static bool hang_sda_level(uint gpio, void *ctx)
+{
+    (void)gpio;
+    return !bus_hung(ctx);
+}
+
+// O escravo termina um bit do byte interrompido a cada borda de subida de SCL
+static void hang_scl_edge(uint gpio, bool value, void *ctx)
+{
+    i2c_inst_t *i2c = ctx;
+    (void)gpio;
+
+    if (value && bus_hung(i2c) && ++i2c->hang_pulses >= MOCK_I2C_HANG_PULSES)
+        i2c->hung = false;
+}
+
+void mock_i2c_hang(i2c_inst_t *i2c, uint64_t at_us, uint sda_gpio, uint scl_gpio)
+{
+    i2c->hang_at_ns = at_us ? at_us * 1000u : 1;
+    i2c->sda_gpio = sda_gpio;
+    i2c->scl_gpio = scl_gpio;
+    mock_gpio_set_input_hook(sda_gpio, hang_sda_level, i2c);
+    mock_gpio_set_output_hook(scl_gpio, hang_scl_edge, i2c);
+}
+
+bool mock_i2c_hung(i2c_inst_t *i2c)
+{
+    return bus_hung(i2c);
+}
+
+void mock_i2c_set_max_baudrate(i2c_inst_t *i2c, uint baudrate)
+{
+    i2c->max_baudrate = baudrate;
+}
+
+const mock_i2c_stats_t *mock_i2c_get_stats(i2c_inst_t *i2c)
+{
+    return &i2c->stats;
+}
+
+void mock_i2c_reset_stats(i2c_inst_t *i2c)
+{
+    memset(&i2c->stats, 0, sizeof(i2c->stats));
+}
+
+// ---------------------------------------------------------------------------
+// Banco de registradores genérico
+// ---------------------------------------------------------------------------
+
+// Primeiro byte escrito posiciona o ponteiro; os seguintes são dados
+static int regfile_write(mock_i2c_device_t *dev, const uint8_t *src, size_t len, bool nostop)
+{
+    mock_i2c_regfile_t *rf = (mock_i2c_regfile_t *)dev;
+    (void)nostop;
+
+    if (len == 0)
+        return 0;
+
+    rf->pointer = src[0];
+    for (size_t i = 1; i < len; ++i) {
+        uint8_t reg = rf->pointer++;
+        rf->regs[reg] = src[i];
+        if (rf->on_write)
+            rf->on_write(rf, reg, src[i]);
+    }
+    return (int)len;
+}
+
+static int regfile_read(mock_i2c_device_t *dev, uint8_t *dst, size_t len, bool nostop)
+{
+    mock_i2c_regfile_t *rf = (mock_i2c_regfile_t *)dev;
+    (void)nostop;
+
+    if (rf->on_read)
+        rf->on_read(rf, rf->pointer);
+    for (size_t i = 0; i < len; ++i)
+        dst[i] = rf->regs[rf->pointer++];
+    return (int)len;
+}
+
+void mock_i2c_regfile_init(mock_i2c_regfile_t *rf, uint8_t address)
+{
+    mock_i2c_device_t *next = rf->dev.next; // Preserva a lista se já estiver ligado
+
+    memset(rf, 0, sizeof(*rf));
+    rf->dev.next = next;
+    rf->dev.address = address;
+    rf->dev.write = regfile_write;
+    rf->dev.read = regfile_read;
+}
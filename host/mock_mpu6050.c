@@ -0,0 +1,105 @@
+// Modelo de registradores do MPU6050 (endereço 0x68).
+
+#include <math.h>
+
+#include "mock_hal.h"
+
+#define MPU6050_ADDR 0x68
+#define REG_ACCEL_XOUT_H 0x3B
+#define REG_PWR_MGMT_1 0x6B
+#define REG_WHO_AM_I 0x75
+
+static mock_i2c_regfile_t mpu;
+static i2c_inst_t *mpu_bus;
+static mock_mpu6050_source_t sample_source;
+static void *sample_ctx;
+static uint32_t samples_served;
+static uint32_t synthetic_step;
+
+static void put_be16(uint8_t *dst, int16_t value)
+{
+    dst[0] = (uint8_t)((uint16_t)value >> 8);
+    dst[1] = (uint8_t)value;
+}
+
+// Sinal sintético: 1 g em Z com vibração lenta nos demais eixos, 25 °C
+static bool synthetic_source(void *ctx, mock_mpu6050_sample_t *out)
+{
+    (void)ctx;
+    float phase = (float)synthetic_step++ * 0.1f;
+
+    out->accel[0] = (int16_t)(2000.0f * sinf(phase));
+    out->accel[1] = (int16_t)(2000.0f * cosf(phase));
+    out->accel[2] = 16384;
+    out->gyro[0] = (int16_t)(500.0f * sinf(phase * 0.5f));
+    out->gyro[1] = (int16_t)(500.0f * cosf(phase * 0.5f));
+    out->gyro[2] = 0;
+    out->temp = (int16_t)((25.0f - 36.53f) * 340.0f);
+    return true;
+}
+
+// Uma nova amostra é "convertida" sempre que o firmware inicia uma leitura em
+// ACCEL_XOUT_H, como o driver faz a cada chamada de mpu6050_read_raw()
+static void mpu_on_read(mock_i2c_regfile_t *rf, uint8_t reg)
+{
+    mock_mpu6050_sample_t s;
+
+    if (reg != REG_ACCEL_XOUT_H || (rf->regs[REG_PWR_MGMT_1] & 0x40))
+        return;
+    if (!sample_source(sample_ctx, &s))
+        return; // Fonte esgotada: mantém a última amostra nos registradores
+
+    for (int i = 0; i < 3; ++i) {
+        put_be16(&rf->regs[REG_ACCEL_XOUT_H + 2 * i], s.accel[i]);
+        put_be16(&rf->regs[0x43 + 2 * i], s.gyro[i]);
+    }
+    put_be16(&rf->regs[0x41], s.temp);
+    samples_served++;
+}
+
+static void mpu_on_write(mock_i2c_regfile_t *rf, uint8_t reg, uint8_t value)
+{
+    // DEVICE_RESET se auto-limpa e restaura o valor padrão (sleep)
+    if (reg == REG_PWR_MGMT_1 && (value & 0x80))
+        rf->regs[REG_PWR_MGMT_1] = 0x40;
+}
+
+// Estado após energizar: registradores zerados, em sleep
+static void mpu_power_on(void)
+{
+    mock_i2c_regfile_init(&mpu, MPU6050_ADDR);
+    mpu.regs[REG_WHO_AM_I] = MPU6050_ADDR;
+    mpu.regs[REG_PWR_MGMT_1] = 0x40;
+    mpu.on_read = mpu_on_read;
+    mpu.on_write = mpu_on_write;
+}
+
+void mock_mpu6050_attach(i2c_inst_t *i2c, mock_mpu6050_source_t source, void *ctx)
+{
+    mpu_power_on();
+    mpu_bus = i2c;
+
+    sample_source = source ? source : synthetic_source;
+    sample_ctx = ctx;
+    samples_served = 0;
+    synthetic_step = 0;
+
+    mock_i2c_attach(i2c, &mpu.dev);
+}
+
+uint32_t mock_mpu6050_samples_served(void)
+{
+    return samples_served;
+}
+
+void mock_mpu6050_set_connected(bool connected)
+{
+    if (!mpu_bus)
+        return;
+    if (connected) {
+        mpu_power_on();
+        mock_i2c_attach(mpu_bus, &mpu.dev);
+    } else {
+        mock_i2c_detach(mpu_bus, &mpu.dev);
+    }
+}
@@ -0,0 +1,160 @@
+// Cartão SD simulado: substitui sd_driver/sd_card.c no build host. Os blocos
+// ficam em RAM e cada comando cobra o tempo de SPI correspondente à taxa
+// configurada em config/hw_config.c.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ff.h"
+#include "diskio.h"
+#include "hw_config.h"
+#include "sd_card.h"
+#include "trace/trace.h"
+#include "mock_hal.h"
+
+#define SD_SECTOR_SIZE 512
+#define SD_CMD_BYTES 8          // Comando (6) + espera/resposta R1
+#define SD_BLOCK_OVERHEAD 4     // Token + CRC16 + data response
+#define SD_PROGRAM_NS 250000ull // Tempo de programação por bloco (busy)
+#define SD_ACCESS_NS 100000ull  // Latência até o token de leitura
+
+static uint8_t *image = NULL;
+static uint32_t image_sectors = 0;
+static mock_sd_stats_t stats;
+
+static void charge_spi(sd_card_t *pSD, uint64_t bytes, uint64_t extra_ns)
+{
+    uint baud = pSD->spi && pSD->spi->baud_rate ? pSD->spi->baud_rate : 400000;
+    uint64_t ns = bytes * 8ull * 1000000000ull / baud + extra_ns;
+
+    stats.busy_ns += ns;
+    mock_clock_advance_ns(ns);
+}
+
+static int mock_sd_init(sd_card_t *pSD)
+{
+    if (!image) {
+        pSD->m_Status |= STA_NODISK;
+        return pSD->m_Status;
+    }
+    pSD->sectors = image_sectors;
+    pSD->m_Status &= ~(STA_NOINIT | STA_NODISK);
+    return pSD->m_Status;
+}
+
+static int mock_sd_read_blocks(sd_card_t *pSD, uint8_t *buffer, uint64_t ulSectorNumber, uint32_t ulSectorCount)
+{
+    if (pSD->m_Status & STA_NOINIT)
+        return SD_BLOCK_DEVICE_ERROR_NO_INIT;
+    if (ulSectorNumber + ulSectorCount > image_sectors)
+        return SD_BLOCK_DEVICE_ERROR_PARAMETER;
+
+    memcpy(buffer, image + ulSectorNumber * SD_SECTOR_SIZE, (size_t)ulSectorCount * SD_SECTOR_SIZE);
+
+    stats.read_cmds++;
+    stats.sectors_read += ulSectorCount;
+    charge_spi(pSD, SD_CMD_BYTES + (uint64_t)ulSectorCount * (SD_SECTOR_SIZE + SD_BLOCK_OVERHEAD),
+               ulSectorCount * SD_ACCESS_NS);
+    return SD_BLOCK_DEVICE_ERROR_NONE;
+}
+
+static int mock_sd_write_blocks(sd_card_t *pSD, const uint8_t *buffer, uint64_t ulSectorNumber, uint32_t blockCnt)
+{
+    if (pSD->m_Status & STA_NOINIT)
+        return SD_BLOCK_DEVICE_ERROR_NO_INIT;
+    if (ulSectorNumber + blockCnt > image_sectors)
+        return SD_BLOCK_DEVICE_ERROR_PARAMETER;
+
+    memcpy(image + ulSectorNumber * SD_SECTOR_SIZE, buffer, (size_t)blockCnt * SD_SECTOR_SIZE);
+
+    stats.write_cmds++;
+    stats.sectors_written += blockCnt;
+    for (uint32_t i = 0; i < blockCnt; ++i) {
+        charge_spi(pSD, (i == 0 ? SD_CMD_BYTES : 0) + SD_SECTOR_SIZE + SD_BLOCK_OVERHEAD, 0);
+
+        // Espera do cartão terminar a programação, como sd_wait_ready() no driver real
+        TRACE_BEGIN(t_wait);
+        charge_spi(pSD, 0, SD_PROGRAM_NS);
+        TRACE_END(TRACE_SD_WAIT_READY, t_wait);
+    }
+    return SD_BLOCK_DEVICE_ERROR_NONE;
+}
+
+static bool mock_sd_test_com(sd_card_t *pSD)
+{
+    (void)pSD;
+    return image != NULL;
+}
+
+bool sd_init_driver()
+{
+    for (size_t i = 0; i < sd_get_num(); ++i) {
+        sd_card_t *pSD = sd_get_by_num(i);
+        if (pSD->init != mock_sd_init) {
+            pSD->m_Status = STA_NOINIT;
+            pSD->init = mock_sd_init;
+            pSD->read_blocks = mock_sd_read_blocks;
+            pSD->write_blocks = mock_sd_write_blocks;
+            pSD->sd_test_com = mock_sd_test_com;
+        }
+    }
+    return true;
+}
+
+bool sd_card_detect(sd_card_t *pSD)
+{
+    if (image) {
+        pSD->m_Status &= ~STA_NODISK;
+        return true;
+    }
+    pSD->m_Status |= (STA_NODISK | STA_NOINIT);
+    return false;
+}
+
+uint64_t sd_sectors(sd_card_t *pSD)
+{
+    (void)pSD;
+    return image_sectors;
+}
+
+bool mock_sd_card_create(uint32_t sectors)
+{
+    free(image);
+    image = calloc(sectors, SD_SECTOR_SIZE);
+    image_sectors = image ? sectors : 0;
+    return image != NULL;
+}
+
+bool mock_sd_card_format(void)
+{
+    static BYTE work[FF_MAX_SS * 8];
+    sd_card_t *pSD = sd_get_by_num(0);
+
+    FRESULT fr = f_mkfs(pSD->pcName, 0, work, sizeof(work));
+    if (fr != FR_OK) {
+        fprintf(stderr, "f_mkfs falhou (%d)\n", fr);
+        return false;
+    }
+    return true;
+}
+
+bool mock_sd_save_image(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+    size_t n = fwrite(image, SD_SECTOR_SIZE, image_sectors, f);
+    fclose(f);
+    return n == image_sectors;
+}
+
+const mock_sd_stats_t *mock_sd_get_stats(void)
+{
+    return &stats;
+}
+
+void mock_sd_reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
@@ -0,0 +1,327 @@
+// SSD1306 simulado: painel virtual que interpreta o fluxo de comandos/dados,
+// mantém a GDDRAM, contabiliza os bytes e agrupa as escritas em quadros.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "mock_hal.h"
+
+#define PANEL_WIDTH 128
+#define PANEL_PAGES 8
+
+static mock_i2c_device_t oled;
+static mock_ssd1306_stats_t stats;
+
+static struct {
+    uint8_t gddram[PANEL_PAGES][PANEL_WIDTH];
+    mock_ssd1306_state_t state;
+
+    // Ponteiro de escrita e janela de endereçamento
+    uint8_t col, page;
+    uint8_t col_start, col_end;
+    uint8_t page_start, page_end;
+
+    // Comando em andamento: argumentos podem chegar em transações separadas
+    uint8_t cmd[7];
+    uint8_t cmd_len, cmd_need;
+} panel;
+
+static struct {
+    mock_ssd1306_frame_t current;
+    bool open;
+    uint64_t last_write_ns;
+    mock_ssd1306_frame_cb_t cb;
+    void *ctx;
+} frame;
+
+static void panel_reset(void)
+{
+    memset(&panel, 0, sizeof(panel));
+    panel.col_end = PANEL_WIDTH - 1;
+    panel.page_end = PANEL_PAGES - 1;
+    panel.state.addressing_mode = 0x02;  // Endereçamento por página após o reset
+    panel.state.mux_ratio = 63;
+    panel.state.contrast = 0x7F;
+}
+
+// Número de bytes de argumento do comando que começa com op
+static uint8_t command_args(uint8_t op)
+{
+    switch (op) {
+    case 0x81: case 0x8D: case 0x20: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+static void run_command(const uint8_t *c)
+{
+    uint8_t op = c[0];
+
+    if (op <= 0x0F) {                       // Coluna (nibble baixo), modo página
+        panel.col = (panel.col & 0xF0) | op;
+    } else if (op <= 0x1F) {                // Coluna (nibble alto), modo página
+        panel.col = (uint8_t)(((op & 0x0F) << 4) | (panel.col & 0x0F)) & (PANEL_WIDTH - 1);
+    } else if (op == 0x20) {
+        panel.state.addressing_mode = c[1] & 0x03;
+    } else if (op == 0x21) {
+        panel.col_start = panel.col = c[1] & (PANEL_WIDTH - 1);
+        panel.col_end = c[2] & (PANEL_WIDTH - 1);
+    } else if (op == 0x22) {
+        panel.page_start = panel.page = c[1] & (PANEL_PAGES - 1);
+        panel.page_end = c[2] & (PANEL_PAGES - 1);
+    } else if (op >= 0x40 && op <= 0x7F) {
+        panel.state.start_line = op & 0x3F;
+    } else if (op == 0x81) {
+        panel.state.contrast = c[1];
+    } else if (op == 0xA4 || op == 0xA5) {
+        panel.state.entire_on = op & 1;
+    } else if (op == 0xA6 || op == 0xA7) {
+        panel.state.inverted = op & 1;
+    } else if (op == 0xA8) {
+        panel.state.mux_ratio = c[1] & 0x3F;
+    } else if (op == 0xAE || op == 0xAF) {
+        panel.state.display_on = op & 1;
+    } else if (op >= 0xB0 && op <= 0xB7) { // Página, modo página
+        panel.page = op & 0x07;
+    }
+    panel.state.commands++;
+}
+
+static void command_byte(uint8_t b)
+{
+    if (panel.cmd_len == 0)
+        panel.cmd_need = 1 + command_args(b);
+    panel.cmd[panel.cmd_len++] = b;
+    if (panel.cmd_len == panel.cmd_need) {
+        run_command(panel.cmd);
+        panel.cmd_len = 0;
+    }
+}
+
+// Grava na GDDRAM e avança o ponteiro conforme o modo de endereçamento
+static void data_byte(uint8_t b)
+{
+    panel.gddram[panel.page][panel.col] = b;
+
+    switch (panel.state.addressing_mode) {
+    case 0x00:  // Horizontal
+        if (panel.col++ >= panel.col_end) {
+            panel.col = panel.col_start;
+            panel.page = panel.page >= panel.page_end ? panel.page_start : panel.page + 1;
+        }
+        break;
+    case 0x01:  // Vertical
+        if (panel.page++ >= panel.page_end) {
+            panel.page = panel.page_start;
+            panel.col = panel.col >= panel.col_end ? panel.col_start : panel.col + 1;
+        }
+        break;
+    default:    // Página: a coluna volta ao início na mesma página
+        panel.col = (panel.col + 1) & (PANEL_WIDTH - 1);
+        break;
+    }
+}
+
+static void close_frame(void)
+{
+    if (!frame.open)
+        return;
+    frame.open = false;
+    if (frame.current.data_bytes == 0)
+        return;  // Só comandos (configuração, contraste...): não é um quadro
+
+    stats.frames++;
+    stats.frame_bytes += frame.current.bytes;
+    stats.last_frame_bytes = frame.current.bytes;
+    if (frame.current.bytes > stats.max_frame_bytes)
+        stats.max_frame_bytes = frame.current.bytes;
+    frame.current.index = stats.frames;
+    if (frame.cb)
+        frame.cb(&frame.current, frame.ctx);
+}
+
+// Escritas separadas por mais de MOCK_SSD1306_FRAME_GAP_NS pertencem a quadros
+// diferentes; o quadro anterior é fechado antes de a escrita nova alterar a GDDRAM
+static void account_frame(size_t len, uint32_t data_bytes)
+{
+    uint64_t now = mock_clock_now_ns();
+
+    if (frame.open && now - frame.last_write_ns > MOCK_SSD1306_FRAME_GAP_NS)
+        close_frame();
+    if (!frame.open) {
+        memset(&frame.current, 0, sizeof(frame.current));
+        frame.current.start_ns = now;
+        frame.open = true;
+    }
+    frame.current.bytes += (uint32_t)len;
+    frame.current.data_bytes += data_bytes;
+    frame.current.transactions++;
+    frame.last_write_ns = now;
+}
+
+// Cada byte de controle traz Co (bit 7) e D/C# (bit 6). Com Co = 0 o resto da
+// transação é do mesmo tipo; com Co = 1 vem um só byte e outro byte de controle.
+static int oled_write(mock_i2c_device_t *dev, const uint8_t *src, size_t len, bool nostop)
+{
+    uint32_t data_bytes = 0, command_bytes = 0;
+    (void)dev;
+    (void)nostop;
+
+    if (len == 0)
+        return 0;
+
+    size_t i = 0;
+    while (i < len) {
+        uint8_t control = src[i++];
+        bool data = control & 0x40;
+        size_t end = (control & 0x80) ? i + 1 : len;
+        if (end > len)
+            end = len;
+
+        for (; i < end; ++i) {
+            if (data) {
+                data_byte(src[i]);
+                data_bytes++;
+            } else {
+                command_byte(src[i]);
+                command_bytes++;
+            }
+        }
+    }
+
+    if (data_bytes) {
+        stats.data_bytes += data_bytes;
+        stats.data_writes++;
+    }
+    stats.command_bytes += command_bytes;
+    account_frame(len, data_bytes);
+    return (int)len;
+}
+
+void mock_ssd1306_attach(i2c_inst_t *i2c, uint8_t address)
+{
+    mock_i2c_device_t *next = oled.next; // Preserva a lista se já estiver ligado
+
+    memset(&oled, 0, sizeof(oled));
+    oled.next = next;
+    oled.address = address;
+    oled.write = oled_write;
+    panel_reset();
+    mock_i2c_attach(i2c, &oled);
+}
+
+const mock_ssd1306_stats_t *mock_ssd1306_get_stats(void)
+{
+    return &stats;
+}
+
+void mock_ssd1306_reset_stats(void)
+{
+    memset(&stats, 0, sizeof(stats));
+}
+
+const mock_ssd1306_state_t *mock_ssd1306_get_state(void)
+{
+    return &panel.state;
+}
+
+uint8_t mock_ssd1306_height(void)
+{
+    return (uint8_t)(panel.state.mux_ratio + 1);
+}
+
+bool mock_ssd1306_pixel(uint8_t x, uint8_t y)
+{
+    if (x >= PANEL_WIDTH || y >= PANEL_PAGES * 8)
+        return false;
+    return (panel.gddram[y >> 3][x] >> (y & 7)) & 1;
+}
+
+void mock_ssd1306_on_frame(mock_ssd1306_frame_cb_t cb, void *ctx)
+{
+    frame.cb = cb;
+    frame.ctx = ctx;
+}
+
+void mock_ssd1306_end_frame(void)
+{
+    close_frame();
+}
+
+// PBM binário (P4): 1 = pixel aceso, linhas de 16 bytes com o MSB à esquerda
+bool mock_ssd1306_save_pbm(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    uint8_t height = mock_ssd1306_height();
+    fprintf(f, "P4\n%d %d\n", PANEL_WIDTH, height);
+    for (uint8_t y = 0; y < height; ++y) {
+        uint8_t row[PANEL_WIDTH / 8] = {0};
+        for (uint8_t x = 0; x < PANEL_WIDTH; ++x)
+            if (mock_ssd1306_pixel(x, y))
+                row[x >> 3] |= 0x80 >> (x & 7);
+        fwrite(row, 1, sizeof(row), f);
+    }
+    return fclose(f) == 0;
+}
+
+static bool pbm_token(FILE *f, int *value)
+{
+    int c;
+
+    do {
+        c = fgetc(f);
+        if (c == '#')
+            while (c != '\n' && c != EOF)
+                c = fgetc(f);
+    } while (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+
+    if (c < '0' || c > '9')
+        return false;
+    *value = 0;
+    while (c >= '0' && c <= '9') {
+        *value = *value * 10 + (c - '0');
+        c = fgetc(f);
+    }
+    return true;  // Consome exatamente um separador após o número
+}
+
+int mock_ssd1306_compare_pbm(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return -1;
+
+    int width, height, diff = 0;
+    char magic[2];
+    if (fread(magic, 1, 2, f) != 2 || magic[0] != 'P' || magic[1] != '4' ||
+        !pbm_token(f, &width) || !pbm_token(f, &height) ||
+        width != PANEL_WIDTH || height != mock_ssd1306_height()) {
+        fclose(f);
+        return -1;
+    }
+
+    for (int y = 0; y < height && diff >= 0; ++y) {
+        uint8_t row[PANEL_WIDTH / 8];
+        if (fread(row, 1, sizeof(row), f) != sizeof(row)) {
+            diff = -1;
+            break;
+        }
+        for (int x = 0; x < PANEL_WIDTH; ++x)
+            if (((row[x >> 3] >> (7 - (x & 7))) & 1) != mock_ssd1306_pixel((uint8_t)x, (uint8_t)y))
+                diff++;
+    }
+    fclose(f);
+    return diff;
+}
@@ -174,6 +174,8 @@ specific language governing permissions and limitations under the License.
 #include "ff.h" /* Obtains integer types */
 //
 #include "diskio.h" /* Declarations of disk functions */  // Needed for STA_NOINIT, ...
+//
+#include "trace/trace.h"
 
 #ifndef SD_CRC_ENABLED
 #define SD_CRC_ENABLED 1
@@ -351,11 +353,13 @@ static bool sd_wait_ready(sd_card_t *pSD, int timeout) {
 
     // Keep sending dummy clocks with DI held high until the card releases the
     // DO line
+    TRACE_BEGIN(t_wait);
     absolute_time_t timeout_time = make_timeout_time_ms(timeout);
     do {
         resp = sd_spi_write(pSD, 0xFF);
     } while (resp == 0x00 &&
              0 < absolute_time_diff_us(get_absolute_time(), timeout_time));
+    TRACE_END(TRACE_SD_WAIT_READY, t_wait);
 
     if (resp == 0x00) DBG_PRINTF("%s failed\r\n", __FUNCTION__);
 
@@ -28,6 +28,7 @@ specific language governing permissions and limitations under the License.
 #include "hw_config.h"
 #include "my_debug.h"
 #include "sd_card.h"
+#include "trace/trace.h"
 
 #define TRACE_PRINTF(fmt, args...)
 //#define TRACE_PRINTF printf  // task_printf
@@ -116,7 +117,9 @@ DRESULT disk_write(BYTE pdrv, /* Physical drive nmuber to identify the drive */
     TRACE_PRINTF(">>> %s\n", __FUNCTION__);
     sd_card_t *p_sd = sd_get_by_num(pdrv);
     if (!p_sd) return RES_PARERR;
+    TRACE_BEGIN(t_disk);
     int rc = p_sd->write_blocks(p_sd, buff, sector, count);
+    TRACE_END(TRACE_DISK_WRITE, t_disk);
     return sdrc2dresult(rc);
 }
 
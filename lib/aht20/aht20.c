@@ -1,79 +1,286 @@
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "aht20.h"
 
-#define AHT20_I2C_ADDR      0x38
-#define AHT20_CMD_INIT      0xBE
-#define AHT20_CMD_TRIGGER   0xAC
-#define AHT20_CMD_RESET     0xBA
 #define AHT20_STATUS_BUSY   0x80  // Bit de status ocupado
 #define AHT20_STATUS_CALIBRATED 0x08  // Bit de calibração
 
-bool aht20_init(i2c_inst_t *i2c) {
-    uint8_t init_cmd[3] = {AHT20_CMD_INIT, 0x08, 0x00};
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, init_cmd, 3, false);
-    sleep_ms(50);  // Aguarda o sensor inicializar
-
-    // Verifica status até que o sensor esteja pronto
-    uint8_t status;
-    for (int i = 0; i < 10; i++) {
-        i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false);
-        if ((status & AHT20_STATUS_CALIBRATED) == AHT20_STATUS_CALIBRATED) {
-            return true;  // Sensor calibrado e pronto
+uint8_t aht20_crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0xFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x31) : (uint8_t)(crc << 1);
         }
-        sleep_ms(10);
     }
+    return crc;
+}
+
+static void aht20_wait(aht20_t *dev, aht20_state_t state, uint32_t ms) {
+    dev->state = state;
+    dev->deadline = make_timeout_time_ms(ms);
+}
 
-    return false;  // Falhou na calibração
+// Zera só a máquina de estados: os contadores de erro somam desde o boot,
+// também nas reinicializações pelo escalonador
+void aht20_begin(aht20_t *dev, i2c_inst_t *i2c) {
+    dev->i2c = i2c;
+    dev->requested = false;
+    dev->busy_retries = 0;
+    memset(dev->raw, 0, sizeof(dev->raw));
+    dev->result = AHT20_NONE;
+    aht20_wait(dev, AHT20_POWER_UP, AHT20_POWER_ON_MS);
 }
 
-bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
+void aht20_reset(aht20_t *dev) {
+    uint8_t reset_cmd = AHT20_CMD_RESET;
+    i2c_async_flush(dev->i2c);
+    i2c_bus_write(dev->i2c, AHT20_I2C_ADDR, &reset_cmd, 1, false);
+    aht20_wait(dev, AHT20_POWER_UP, AHT20_RESET_MS);
+}
+
+void aht20_request(aht20_t *dev) {
+    if (dev->state == AHT20_FAULT) {
+        aht20_wait(dev, AHT20_POWER_UP, 0);
+    }
+    dev->requested = true;
+}
+
+static bool aht20_trigger(aht20_t *dev) {
     uint8_t trigger_cmd[3] = {AHT20_CMD_TRIGGER, 0x33, 0x00};
-    uint8_t buffer[6];
+    if (i2c_bus_write(dev->i2c, AHT20_I2C_ADDR, trigger_cmd, 3, false) != 3) {
+        dev->bus_errors++;
+        return false;
+    }
+    dev->busy_retries = 0;
+    aht20_wait(dev, AHT20_MEASURING, AHT20_MEASUREMENT_MS);
+    return true;
+}
 
-    // Envia comando de medição
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, trigger_cmd, 3, false);
-    
-    // Aguarda até o sensor estar pronto
+// Etapas de inicialização: confere a calibração e, se preciso, envia o
+// comando de inicialização e confere de novo depois de AHT20_CALIBRATION_MS
+static void aht20_step_init(aht20_t *dev) {
     uint8_t status;
-    for (int i = 0; i < 10; i++) {
-        i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false);
-        if (!(status & AHT20_STATUS_BUSY)) {
-            break;
+    if (i2c_bus_read(dev->i2c, AHT20_I2C_ADDR, &status, 1, false) != 1) {
+        dev->bus_errors++;
+        dev->state = AHT20_FAULT;  // Sensor ausente
+        return;
+    }
+    if (status & AHT20_STATUS_CALIBRATED) {
+        dev->state = AHT20_IDLE;
+        return;
+    }
+    if (dev->state == AHT20_CALIBRATING) {
+        dev->state = AHT20_FAULT;  // Falhou na calibração
+        return;
+    }
+
+    uint8_t init_cmd[3] = {AHT20_CMD_INIT, 0x08, 0x00};
+    if (i2c_bus_write(dev->i2c, AHT20_I2C_ADDR, init_cmd, 3, false) != 3) {
+        dev->bus_errors++;
+        dev->state = AHT20_FAULT;
+        return;
+    }
+    aht20_wait(dev, AHT20_CALIBRATING, AHT20_CALIBRATION_MS);
+}
+
+// Coleta a resposta da medição: estado, umidade/temperatura (20 bits cada) e CRC8
+static aht20_result_t aht20_collect(aht20_t *dev) {
+    if (i2c_bus_read(dev->i2c, AHT20_I2C_ADDR, dev->raw, AHT20_RESPONSE_LEN, false) != AHT20_RESPONSE_LEN) {
+        dev->bus_errors++;
+        dev->state = AHT20_IDLE;
+        return AHT20_FAILED;
+    }
+    if (dev->raw[0] & AHT20_STATUS_BUSY) {
+        if (++dev->busy_retries <= AHT20_BUSY_RETRIES) {
+            dev->deadline = make_timeout_time_ms(AHT20_BUSY_RETRY_MS);
+            return AHT20_PENDING;
         }
-        sleep_ms(10);
+        dev->busy_timeouts++;
+        dev->state = AHT20_IDLE;
+        return AHT20_FAILED;
     }
-    
-    // Se ainda estiver ocupado, falha na leitura
-    if (status & AHT20_STATUS_BUSY) {
-        return false;
+
+    dev->state = AHT20_IDLE;
+    if (aht20_crc8(dev->raw, AHT20_RESPONSE_LEN - 1) != dev->raw[AHT20_RESPONSE_LEN - 1]) {
+        dev->crc_errors++;
+        return AHT20_FAILED;
     }
+    return AHT20_DONE;
+}
 
-    // Lê os 6 bytes de dados
-    if (i2c_read_blocking(i2c, AHT20_I2C_ADDR, buffer, 6, false) != 6) {
-        return false;
+static aht20_result_t aht20_advance(aht20_t *dev) {
+    aht20_result_t result = dev->requested ? AHT20_PENDING : AHT20_NONE;
+
+    if (dev->state == AHT20_FAULT) {
+        if (dev->requested) {
+            dev->requested = false;
+            return AHT20_FAILED;
+        }
+        return AHT20_NONE;
+    }
+    if (dev->state != AHT20_IDLE && !time_reached(dev->deadline)) {
+        return result;
+    }
+    if (dev->state != AHT20_IDLE || dev->requested) {
+        i2c_async_flush(dev->i2c);  // Leituras por DMA do mesmo barramento
+    }
+
+    switch (dev->state) {
+    case AHT20_POWER_UP:
+    case AHT20_CALIBRATING:
+        aht20_step_init(dev);
+        if (dev->state == AHT20_FAULT) {
+            return aht20_advance(dev);
+        }
+        break;
+    case AHT20_MEASURING:
+        result = aht20_collect(dev);
+        if (result != AHT20_PENDING) {
+            dev->requested = false;
+            return result;
+        }
+        break;
+    default:
+        break;
     }
 
-    // Processa os dados de umidade (20 bits)
-    uint32_t raw_humidity = ((uint32_t)buffer[1] << 12) | ((uint32_t)buffer[2] << 4) | (buffer[3] >> 4);
-    data->humidity = (float)raw_humidity * 100.0 / 1048576.0;
+    // Sensor pronto e medição pedida: dispara agora
+    if (dev->state == AHT20_IDLE && dev->requested && !aht20_trigger(dev)) {
+        dev->requested = false;
+        return AHT20_FAILED;
+    }
+    return result;
+}
 
-    // Processa os dados de temperatura (20 bits)
-    uint32_t raw_temp = ((uint32_t)(buffer[3] & 0x0F) << 16) | ((uint32_t)buffer[4] << 8) | buffer[5];
-    data->temperature = ((float)raw_temp * 200.0 / 1048576.0) - 50.0;
+aht20_result_t aht20_poll(aht20_t *dev) {
+    aht20_result_t result = aht20_advance(dev);
 
-    return true;
+    if (result == AHT20_DONE || result == AHT20_FAILED) {
+        dev->result = result;
+    }
+    return result;
 }
 
-void aht20_reset(i2c_inst_t *i2c) {
-    uint8_t reset_cmd = AHT20_CMD_RESET;
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, &reset_cmd, 1, false);
-    sleep_ms(20);
-    aht20_init(i2c);
+int32_t aht20_humidity_centi_percent(uint32_t raw_humidity) {
+    // 10000 / 2^20 = 625 / 2^16; raw < 2^20 mantém o produto em 32 bits
+    return (int32_t)((raw_humidity * 625u + 32768u) >> 16);
+}
+
+int32_t aht20_temp_centi_celsius(uint32_t raw_temp) {
+    // 20000 / 2^20 = 1250 / 2^16, com o deslocamento de -50 °C na mesma escala
+    int32_t num = (int32_t)(raw_temp * 1250u) - 5000 * 65536;
+    return num >= 0 ? (num + 32768) >> 16 : -((-num + 32768) >> 16);
+}
+
+void aht20_decode(const uint8_t raw[AHT20_RESPONSE_LEN], AHT20_Data *data) {
+    // Umidade e temperatura: 20 bits cada, com o nibble do meio compartilhado
+    uint32_t raw_humidity = ((uint32_t)raw[1] << 12) | ((uint32_t)raw[2] << 4) | (raw[3] >> 4);
+    uint32_t raw_temp = ((uint32_t)(raw[3] & 0x0F) << 16) | ((uint32_t)raw[4] << 8) | raw[5];
+
+    data->humidity = aht20_humidity_centi_percent(raw_humidity);
+    data->temperature = aht20_temp_centi_celsius(raw_temp);
+}
+
+bool aht20_init(aht20_t *dev, i2c_inst_t *i2c) {
+    aht20_begin(dev, i2c);
+    while (dev->state == AHT20_POWER_UP || dev->state == AHT20_CALIBRATING) {
+        sleep_until(dev->deadline);
+        aht20_poll(dev);
+    }
+    return dev->state == AHT20_IDLE;
+}
+
+bool aht20_read(aht20_t *dev, AHT20_Data *data) {
+    aht20_result_t result;
+
+    aht20_request(dev);
+    while ((result = aht20_poll(dev)) == AHT20_PENDING) {
+        sleep_until(dev->deadline);
+    }
+    if (result != AHT20_DONE) {
+        return false;
+    }
+    aht20_decode(dev->raw, data);
+    return true;
 }
 
 bool aht20_check(i2c_inst_t *i2c) {
     uint8_t status;
-    return i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false) == 1;
+    return i2c_bus_read(i2c, AHT20_I2C_ADDR, &status, 1, false) == 1;
 }
+
+// ---------------------------------------------------------------------------
+// Interface de sensor
+// ---------------------------------------------------------------------------
+
+static const sensor_channel_t aht20_channels[] = {
+    {"AHT_Temp", 2},
+    {"Umidade", 2},
+};
+
+// Só confere se o sensor responde; a inicialização segue em aht20_poll()
+static bool aht20_sensor_init(sensor_t *s) {
+    i2c_inst_t *i2c = i2c_dev_init(I2C_DEV_AHT20);
+
+    i2c_async_flush(i2c);  // Na reinicialização, a rajada pode estar na fila
+    if (!aht20_check(i2c)) {
+        return false;
+    }
+    aht20_begin(s->ctx, i2c);
+    return true;
+}
+
+// Dispara a medição na hora, se o sensor estiver pronto, para o resultado
+// sair AHT20_MEASUREMENT_MS (conversion_us) depois, na primeira consulta
+static bool aht20_sensor_start(sensor_t *s) {
+    aht20_t *dev = s->ctx;
+
+    aht20_request(dev);
+    return aht20_poll(dev) == AHT20_PENDING;
+}
+
+// Pronto quando a medição termina, com ou sem sucesso; read() separa os casos
+static bool aht20_sensor_ready(sensor_t *s) {
+    aht20_t *dev = s->ctx;
+
+    if (aht20_poll(dev) != AHT20_PENDING) {
+        return true;
+    }
+    s->ready_us = to_us_since_boot(dev->deadline);  // Nada a fazer antes do prazo da etapa
+    return false;
+}
+
+static bool aht20_sensor_read(sensor_t *s, uint8_t *raw) {
+    aht20_t *dev = s->ctx;
+
+    if (dev->result != AHT20_DONE) {
+        return false;
+    }
+    memcpy(raw, dev->raw, AHT20_RESPONSE_LEN);
+    return true;
+}
+
+static void aht20_sensor_decode(sensor_t *s, const uint8_t *raw, int32_t *values) {
+    AHT20_Data data;
+    (void)s;
+
+    aht20_decode(raw, &data);
+    values[0] = data.temperature;
+    values[1] = data.humidity;
+}
+
+const sensor_driver_t aht20_sensor = {
+    .name = "AHT20",
+    .channels = aht20_channels,
+    .num_channels = 2,
+    .period_us = 2000000,
+    .conversion_us = AHT20_MEASUREMENT_MS * 1000,
+    .init = aht20_sensor_init,
+    .start = aht20_sensor_start,
+    .ready = aht20_sensor_ready,
+    .read = aht20_sensor_read,
+    .decode = aht20_sensor_decode,
+};
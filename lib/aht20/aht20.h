@@ -1,6 +1,16 @@
 #ifndef AHT20_H
 #define AHT20_H
 
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "sensor/sensor.h"
+#include "i2c_bus/i2c_bus.h"
+#include "i2c_bus/i2c_async.h"
+
+// Barramento do AHT20 (config/i2c_config.c)
+#define AHT20_I2C_PORT i2c_dev_port(I2C_DEV_AHT20)
 
 // Endereço I2C do AHT20
 #define AHT20_I2C_ADDR  0x38
@@ -10,21 +20,95 @@
 #define AHT20_CMD_TRIGGER   0xAC
 #define AHT20_CMD_RESET     0xBA
 
-// Estrutura para armazenar os valores de temperatura e umidade
+// Tempos do datasheet
+#define AHT20_POWER_ON_MS    40  // Após energizar, antes do primeiro comando
+#define AHT20_RESET_MS       20  // Após o soft reset
+#define AHT20_CALIBRATION_MS 10  // Após o comando de inicialização
+#define AHT20_MEASUREMENT_MS 80  // Conversão de uma medição
+
+// Nova leitura quando a medição ainda não terminou, e quantas vezes tentar
+#define AHT20_BUSY_RETRY_MS  10
+#define AHT20_BUSY_RETRIES   5
+
+// Resposta de uma medição: estado, 5 bytes de dados e CRC8
+#define AHT20_RESPONSE_LEN   7
+
+// Temperatura e umidade em centésimos (°C e %UR); converter para float só
+// na hora de exibir
 typedef struct {
-    float temperature;
-    float humidity;
+    int32_t temperature;
+    int32_t humidity;
 } AHT20_Data;
 
-// Inicializa o sensor AHT20
-bool aht20_init(i2c_inst_t *i2c);
+// Etapas da máquina de estados. A inicialização e a medição avançam em
+// aht20_poll() quando o prazo da etapa vence; nenhuma chamada espera o sensor.
+typedef enum {
+    AHT20_POWER_UP,      // Aguardando o sensor ligar (ou voltar do reset)
+    AHT20_CALIBRATING,   // Comando de inicialização enviado
+    AHT20_IDLE,
+    AHT20_MEASURING,     // Medição disparada; resultado após o prazo
+    AHT20_FAULT          // Sem resposta ou sem calibração; aht20_request() reinicia
+} aht20_state_t;
+
+// Resultado de aht20_poll()
+typedef enum {
+    AHT20_NONE,          // Nenhuma medição pedida
+    AHT20_PENDING,       // Medição pedida, ainda em andamento
+    AHT20_DONE,          // Medição concluída: dados em raw
+    AHT20_FAILED         // Medição perdida (NACK, CRC ou sensor sempre ocupado)
+} aht20_result_t;
+
+typedef struct {
+    i2c_inst_t *i2c;
+    aht20_state_t state;
+    absolute_time_t deadline;      // Fim da espera da etapa atual
+    bool requested;                // Medição pedida e ainda não entregue
+    uint8_t busy_retries;
+    uint8_t raw[AHT20_RESPONSE_LEN];
+    aht20_result_t result;         // Desfecho da última medição (AHT20_DONE/AHT20_FAILED)
+
+    uint32_t crc_errors;
+    uint32_t bus_errors;           // NACKs
+    uint32_t busy_timeouts;        // Medições que não terminaram após as novas tentativas
+} aht20_t;
 
-// Faz a leitura de temperatura e umidade do AHT20
-bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data);
+// Inicia a máquina de estados sem bloquear; o sensor fica pronto depois de
+// AHT20_POWER_ON_MS (+ AHT20_CALIBRATION_MS se precisar calibrar). Preserva
+// os contadores de erro; dev deve começar zerado (estático ou memset).
+void aht20_begin(aht20_t *dev, i2c_inst_t *i2c);
 
-// Reseta o sensor AHT20
-void aht20_reset(i2c_inst_t *i2c);
+// Pede uma medição; ela é disparada assim que o sensor estiver pronto.
+// Num sensor em falha, reinicia a inicialização.
+void aht20_request(aht20_t *dev);
+
+// Avança a máquina de estados; chamar periodicamente. Retorna AHT20_DONE ou
+// AHT20_FAILED uma única vez por medição pedida.
+aht20_result_t aht20_poll(aht20_t *dev);
+
+// Converte a resposta de uma medição concluída
+void aht20_decode(const uint8_t raw[AHT20_RESPONSE_LEN], AHT20_Data *data);
+
+// Conversões dos valores crus de 20 bits, em ponto fixo e arredondando a
+// metade para longe do zero: umidade = raw * 100 / 2^20 em centésimos de %UR,
+// temperatura = raw * 200 / 2^20 - 50 em centésimos de grau Celsius
+int32_t aht20_humidity_centi_percent(uint32_t raw_humidity);
+int32_t aht20_temp_centi_celsius(uint32_t raw_temp);
+
+// CRC8 do AHT20 (polinômio 0x31, valor inicial 0xFF)
+uint8_t aht20_crc8(const uint8_t *data, size_t len);
+
+// Versões bloqueantes, sobre a máquina de estados
+bool aht20_init(aht20_t *dev, i2c_inst_t *i2c);
+bool aht20_read(aht20_t *dev, AHT20_Data *data);
+
+// Soft reset; a máquina de estados reinicia a inicialização sem bloquear
+void aht20_reset(aht20_t *dev);
 
 bool aht20_check(i2c_inst_t *i2c);
 
+// Sensor para o escalonador (ctx: aht20_t): AHT_Temp e Umidade em centésimos.
+// A medição é disparada num período e coletada AHT20_MEASUREMENT_MS depois,
+// com o CRC conferido, sem espera ativa.
+extern const sensor_driver_t aht20_sensor;
+
 #endif // AHT20_H
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "bmp280.h"
 #include "hardware/i2c.h"
 
@@ -9,35 +10,118 @@ void bmp280_init(i2c_inst_t *i2c) {
     buf[0] = REG_CONFIG;
     buf[1] = reg_config_val;
    
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
 
     const uint8_t reg_ctrl_meas_val = (0x01 << 5) | (0x03 << 2) | (0x03);
     buf[0] = REG_CTRL_MEAS;
     buf[1] = reg_ctrl_meas_val;
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
  //   printf("Ctrl_meas register value: %x\n", reg_ctrl_meas_val);
 }
 
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
     uint8_t buf[6];
     uint8_t reg = REG_PRESSURE_MSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, 6, false);
+    if (i2c_bus_write(i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(i2c, ADDR, buf, 6, false) != 6)
+        return false;
 
     *pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
     *temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
+    return true;
+}
+
+const bmp280_config_t bmp280_presets[BMP280_NUM_PRESETS] = {
+    [BMP280_PRESET_STANDARD]   = {"padrao", BMP280_MODE_NORMAL, 1, 3, 4, 4},
+    [BMP280_PRESET_WEATHER]    = {"clima", BMP280_MODE_FORCED, 1, 1, 0, 0},
+    [BMP280_PRESET_PRECISION]  = {"precisao", BMP280_MODE_FORCED, 2, 5, 2, 0},
+    [BMP280_PRESET_NAVIGATION] = {"navegacao", BMP280_MODE_NORMAL, 2, 5, 4, 0},
+};
+
+static bool bmp280_write_reg(i2c_inst_t *i2c, uint8_t reg, uint8_t value) {
+    uint8_t buf[2] = { reg, value };
+    return i2c_bus_write(i2c, ADDR, buf, 2, false) == 2;
+}
+
+uint32_t bmp280_measurement_us(const bmp280_config_t *config) {
+    // 1,25 ms + 2,3 ms por passo de sobreamostragem (+ 0,575 ms com pressão)
+    static const uint8_t steps[6] = {0, 1, 2, 4, 8, 16};
+    uint32_t t = steps[config->osrs_t], p = steps[config->osrs_p];
+    return 1250 + 2300 * (t + p) + (p ? 575 : 0);
+}
+
+bool bmp280_configure(bmp280_t *dev, const bmp280_config_t *config) {
+    uint8_t osrs = (uint8_t)((config->osrs_t << 5) | (config->osrs_p << 2));
+
+    dev->config = config;
+    dev->config_reg = (uint8_t)((config->standby << 5) | (config->filter << 2));
+    dev->ctrl_meas = osrs | (config->mode == BMP280_MODE_NORMAL ? BMP280_MODE_NORMAL : BMP280_MODE_SLEEP);
+    dev->measurement_us = bmp280_measurement_us(config);
+    dev->ready_at = get_absolute_time();
+    i2c_async_flush(dev->i2c);
+
+    // CONFIG só é aceito de forma confiável com o sensor em sleep
+    return bmp280_write_reg(dev->i2c, REG_CTRL_MEAS, osrs | BMP280_MODE_SLEEP) &&
+           bmp280_write_reg(dev->i2c, REG_CONFIG, dev->config_reg) &&
+           bmp280_write_reg(dev->i2c, REG_CTRL_MEAS, dev->ctrl_meas);
+}
+
+bool bmp280_set_preset(bmp280_t *dev, bmp280_preset_t preset) {
+    if (preset >= BMP280_NUM_PRESETS)
+        return false;
+    return bmp280_configure(dev, &bmp280_presets[preset]);
+}
+
+bool bmp280_trigger(bmp280_t *dev) {
+    if (dev->config->mode != BMP280_MODE_FORCED)
+        return true;
+    i2c_async_flush(dev->i2c);
+    if (!bmp280_write_reg(dev->i2c, REG_CTRL_MEAS, dev->ctrl_meas | BMP280_MODE_FORCED))
+        return false;
+    dev->ready_at = make_timeout_time_us(dev->measurement_us);
+    return true;
+}
 
+bmp280_status_t bmp280_read_burst(bmp280_t *dev, int32_t *temp, int32_t *pressure) {
+    uint8_t buf[BMP280_BURST_LEN];
+    uint8_t reg = REG_STATUS;
+    i2c_async_flush(dev->i2c);
+    if (i2c_bus_write(dev->i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(dev->i2c, ADDR, buf, BMP280_BURST_LEN, false) != BMP280_BURST_LEN)
+        return BMP280_ERROR;
+    return bmp280_parse_burst(dev, buf, temp, pressure);
+}
+
+bmp280_status_t bmp280_parse_burst(bmp280_t *dev, const uint8_t buf[BMP280_BURST_LEN], int32_t *temp,
+                                   int32_t *pressure) {
+    // buf: status, ctrl_meas, config, reservado, pressão (3), temperatura (3).
+    // No modo forçado o sensor volta sozinho ao sleep: os bits de modo lidos
+    // só valem no modo normal.
+    bool forced = dev->config->mode == BMP280_MODE_FORCED;
+    uint8_t mode_mask = forced ? 0xFC : 0xFF;
+    if ((buf[1] & mode_mask) != dev->ctrl_meas || buf[2] != dev->config_reg) {
+        dev->reconfigs++;
+        bmp280_configure(dev, dev->config);
+        return BMP280_ERROR;
+    }
+    if (forced && ((buf[0] & BMP280_STATUS_MEASURING) || (buf[1] & 0x03))) {
+        dev->busy_reads++;
+        return BMP280_BUSY;
+    }
 
+    *pressure = (buf[4] << 12) | (buf[5] << 4) | (buf[6] >> 4);
+    *temp = (buf[7] << 12) | (buf[8] << 4) | (buf[9] >> 4);
+    return BMP280_OK;
 }
 
 void bmp280_reset(i2c_inst_t *i2c) {
     uint8_t buf[2] = { REG_RESET, 0xB6 };
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_bus_write(i2c, ADDR, buf, 2, false);
 }
 
 // função intermediária que calcula a temperatura de resolução fina
 // usada tanto para conversões de pressão quanto de temperatura
-int32_t bmp280_convert(int32_t temp, struct bmp280_calib_param* params) {
+static int32_t bmp280_t_fine(int32_t temp, const struct bmp280_calib_param* params) {
     // usa os 32 bits de compensação de ponto fixo implementados no datasheet
     int32_t var1, var2;
     var1 = ((((temp >> 3) - ((int32_t)params->dig_t1 << 1))) * ((int32_t)params->dig_t2)) >> 11;
@@ -45,18 +129,8 @@ int32_t bmp280_convert(int32_t temp, struct bmp280_calib_param* params) {
     return var1 + var2;
 }
 
-int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params) {
-    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de temperatura lido de seus registradores
-    int32_t t_fine = bmp280_convert(temp, params);
-    return (t_fine * 5 + 128) >> 8;
-}
-
-
-int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params) {
-    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de pressão lido de seus registradores
-
-    int32_t t_fine = bmp280_convert(temp, params);
-
+// Fórmula de 32 bits do datasheet, em Pa
+static uint32_t bmp280_pressure32(int32_t pressure, int32_t t_fine, const struct bmp280_calib_param* params) {
     int32_t var1, var2;
     uint32_t converted = 0.0;
     var1 = (((int32_t)t_fine) >> 1) - (int32_t)64000;
@@ -80,11 +154,68 @@ int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_ca
     return converted;
 }
 
+// Fórmula de 64 bits do datasheet, em Pa Q24.8
+static uint32_t bmp280_pressure64(int32_t pressure, int32_t t_fine, const struct bmp280_calib_param* params) {
+    int64_t var1, var2, p;
+    var1 = ((int64_t)t_fine) - 128000;
+    var2 = var1 * var1 * (int64_t)params->dig_p6;
+    var2 = var2 + ((var1 * (int64_t)params->dig_p5) << 17);
+    var2 = var2 + (((int64_t)params->dig_p4) << 35);
+    var1 = ((var1 * var1 * (int64_t)params->dig_p3) >> 8) + ((var1 * (int64_t)params->dig_p2) << 12);
+    var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)params->dig_p1) >> 33;
+    if (var1 == 0) {
+        return 0;  // evita a divisão por zero
+    }
+    p = 1048576 - pressure;
+    p = (((p << 31) - var2) * 3125) / var1;
+    var1 = (((int64_t)params->dig_p9) * (p >> 13) * (p >> 13)) >> 25;
+    var2 = (((int64_t)params->dig_p8) * p) >> 19;
+    p = ((p + var1 + var2) >> 8) + (((int64_t)params->dig_p7) << 4);
+    return (uint32_t)p;
+}
+
+int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params) {
+    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de temperatura lido de seus registradores
+    int32_t t_fine = bmp280_t_fine(temp, params);
+    return (t_fine * 5 + 128) >> 8;
+}
+
+int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params) {
+    // Utiliza os parâmetros de calibração do BMP280 para compensar o valor de pressão lido de seus registradores
+    return bmp280_pressure32(pressure, bmp280_t_fine(temp, params), params);
+}
+
+int32_t bmp280_compensate_temp(bmp280_t *dev, int32_t raw_temp) {
+    dev->t_fine = bmp280_t_fine(raw_temp, &dev->calib);
+    return (dev->t_fine * 5 + 128) >> 8;
+}
+
+uint32_t bmp280_compensate_pressure(const bmp280_t *dev, int32_t raw_pressure) {
+    return bmp280_pressure32(raw_pressure, dev->t_fine, &dev->calib);
+}
+
+uint32_t bmp280_compensate_pressure64(const bmp280_t *dev, int32_t raw_pressure) {
+    return bmp280_pressure64(raw_pressure, dev->t_fine, &dev->calib);
+}
+
+void bmp280_compensate_batch(bmp280_t *dev, const int32_t *raw_temp, const int32_t *raw_pressure,
+                             int32_t *temp, uint32_t *pressure, size_t n) {
+    const struct bmp280_calib_param *params = &dev->calib;
+    int32_t t_fine = dev->t_fine;
+
+    for (size_t i = 0; i < n; i++) {
+        t_fine = bmp280_t_fine(raw_temp[i], params);
+        temp[i] = (t_fine * 5 + 128) >> 8;
+        pressure[i] = bmp280_pressure64(raw_pressure[i], t_fine, params);
+    }
+    dev->t_fine = t_fine;
+}
+
 void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
     uint8_t buf[NUM_CALIB_PARAMS] = { 0 };
     uint8_t reg = REG_DIG_T1_LSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, NUM_CALIB_PARAMS, false);
+    i2c_bus_write(i2c, ADDR, &reg, 1, true);
+    i2c_bus_read(i2c, ADDR, buf, NUM_CALIB_PARAMS, false);
 
     params->dig_t1 = (uint16_t)(buf[1] << 8) | buf[0];
     params->dig_t2 = (int16_t)(buf[3] << 8) | buf[2];
@@ -99,6 +230,101 @@ void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params)
     params->dig_p7 = (int16_t)(buf[19] << 8) | buf[18];
     params->dig_p8 = (int16_t)(buf[21] << 8) | buf[20];
     params->dig_p9 = (int16_t)(buf[23] << 8) | buf[22];
+}
+
+bool bmp280_begin(bmp280_t *dev, i2c_inst_t *i2c) {
+    uint8_t reg = REG_CHIP_ID, id = 0;
+
+    i2c_async_flush(i2c);  // Na reinicialização, a rajada pode estar na fila
+    // Os contadores somam desde o boot, também nas reinicializações pelo escalonador
+    uint32_t busy_reads = dev->busy_reads, reconfigs = dev->reconfigs;
+    memset(dev, 0, sizeof(*dev));
+    dev->busy_reads = busy_reads;
+    dev->reconfigs = reconfigs;
+    dev->i2c = i2c;
+    dev->xfer.dev = I2C_DEV_BMP280;
+    dev->xfer.reg = REG_STATUS;
+    dev->xfer.len = BMP280_BURST_LEN;
+    dev->xfer.dst = dev->burst;
+    if (i2c_bus_write(i2c, ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(i2c, ADDR, &id, 1, false) != 1 || id != BMP280_CHIP_ID)
+        return false;
 
+    bmp280_get_calib_params(i2c, &dev->calib);
+    return bmp280_set_preset(dev, BMP280_PRESET_STANDARD);
+}
+
+// ---------------------------------------------------------------------------
+// Interface de sensor
+// ---------------------------------------------------------------------------
+
+static const sensor_channel_t bmp280_channels[] = {
+    {"BMP_Temp", 2},
+    {"Pressao", 0},
+};
+
+// Confere o ID do chip antes de configurar: sem resposta, o sensor é ignorado
+static bool bmp280_sensor_init(sensor_t *s) {
+    return bmp280_begin(s->ctx, i2c_dev_init(I2C_DEV_BMP280));
+}
+
+static bool bmp280_sensor_start(sensor_t *s) {
+    bmp280_t *dev = s->ctx;
+
+    if (i2c_xfer_pending(&dev->xfer))
+        return false;
+    dev->xfer.status = I2C_XFER_IDLE;
+    return bmp280_trigger(dev);
+}
+
+// No modo forçado espera o tempo máximo de conversão; depois põe a rajada na
+// fila do DMA e fica pronto quando ela chega (read() ainda confere o status)
+static bool bmp280_sensor_ready(sensor_t *s) {
+    bmp280_t *dev = s->ctx;
 
+    if (dev->config->mode == BMP280_MODE_FORCED && !time_reached(dev->ready_at)) {
+        s->ready_us = to_us_since_boot(dev->ready_at);
+        return false;
+    }
+    if (dev->xfer.status == I2C_XFER_IDLE) {
+        return !i2c_async_submit(&dev->xfer);
+    }
+    i2c_async_poll();
+    return !i2c_xfer_pending(&dev->xfer);
+}
+
+static bool bmp280_sensor_read(sensor_t *s, uint8_t *raw) {
+    bmp280_t *dev = s->ctx;
+    int32_t temp, pressure;
+
+    if (dev->xfer.status != I2C_XFER_DONE ||
+        bmp280_parse_burst(dev, dev->burst, &temp, &pressure) != BMP280_OK)
+        return false;
+    memcpy(raw, &temp, sizeof(temp));
+    memcpy(raw + sizeof(temp), &pressure, sizeof(pressure));
+    return true;
 }
+
+// Caminho de 64 bits, arredondado para Pa inteiro
+static void bmp280_sensor_decode(sensor_t *s, const uint8_t *raw, int32_t *values) {
+    bmp280_t *dev = s->ctx;
+    int32_t temp, pressure;
+
+    memcpy(&temp, raw, sizeof(temp));
+    memcpy(&pressure, raw + sizeof(temp), sizeof(pressure));
+    values[0] = bmp280_compensate_temp(dev, temp);
+    values[1] = (int32_t)((bmp280_compensate_pressure64(dev, pressure) + 128) >> 8);
+}
+
+const sensor_driver_t bmp280_sensor = {
+    .name = "BMP280",
+    .channels = bmp280_channels,
+    .num_channels = 2,
+    .period_us = 1000000,
+    .conversion_us = 0,
+    .init = bmp280_sensor_init,
+    .start = bmp280_sensor_start,
+    .ready = bmp280_sensor_ready,
+    .read = bmp280_sensor_read,
+    .decode = bmp280_sensor_decode,
+};
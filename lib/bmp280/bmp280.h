@@ -2,10 +2,20 @@
 #define BMP280_H
 
 #include "hardware/i2c.h"
+#include "sensor/sensor.h"
+#include "i2c_bus/i2c_bus.h"
+#include "i2c_bus/i2c_async.h"
+
+// Barramento do BMP280 (config/i2c_config.c)
+#define BMP280_I2C_PORT i2c_dev_port(I2C_DEV_BMP280)
 
 // Defina os endereços e registros conforme o código original
 #define ADDR _u(0x77)
 
+#define REG_CHIP_ID _u(0xD0)
+#define BMP280_CHIP_ID 0x58
+
+#define REG_STATUS _u(0xF3)
 #define REG_CONFIG _u(0xF5)
 #define REG_CTRL_MEAS _u(0xF4)
 #define REG_RESET _u(0xE0)
@@ -45,6 +55,49 @@
 
 #define NUM_CALIB_PARAMS 24
 
+// Bits do registrador de status
+#define BMP280_STATUS_MEASURING 0x08
+#define BMP280_STATUS_IM_UPDATE 0x01
+
+// Leitura em rajada de STATUS (0xF3) até TEMP_XLSB (0xFC)
+#define BMP280_BURST_LEN 10
+
+typedef enum {
+    BMP280_MODE_SLEEP = 0x00,
+    BMP280_MODE_FORCED = 0x01,   // Uma conversão por disparo, depois volta ao sleep
+    BMP280_MODE_NORMAL = 0x03    // Conversões contínuas separadas pelo standby
+} bmp280_mode_t;
+
+// Configuração de medição. Sobreamostragem (osrs_t, osrs_p): 0 = canal
+// desligado, 1..5 = x1, x2, x4, x8, x16. Filtro IIR: 0 = desligado, 1..4 =
+// coeficiente 2, 4, 8, 16. Standby do modo normal: 0..7 = 0,5, 62,5, 125,
+// 250, 500, 1000, 2000, 4000 ms.
+typedef struct {
+    const char *name;
+    bmp280_mode_t mode;
+    uint8_t osrs_t;
+    uint8_t osrs_p;
+    uint8_t filter;
+    uint8_t standby;
+} bmp280_config_t;
+
+// Perfis baseados nos casos de uso do datasheet (seção 3.8)
+typedef enum {
+    BMP280_PRESET_STANDARD,      // Normal, P x4, T x1, IIR 16, 500 ms (configuração original)
+    BMP280_PRESET_WEATHER,       // Forçado, P x1, T x1, sem filtro: menor consumo e ruído
+    BMP280_PRESET_PRECISION,     // Forçado, P x16, T x2, IIR 4: maior resolução por amostra
+    BMP280_PRESET_NAVIGATION,    // Normal, P x16, T x2, IIR 16, 0,5 ms: taxa e resolução máximas
+    BMP280_NUM_PRESETS
+} bmp280_preset_t;
+
+extern const bmp280_config_t bmp280_presets[BMP280_NUM_PRESETS];
+
+typedef enum {
+    BMP280_OK,
+    BMP280_BUSY,                 // Conversão forçada ainda em andamento
+    BMP280_ERROR                 // Sem resposta ou configuração perdida (sensor reiniciado)
+} bmp280_status_t;
+
 struct bmp280_calib_param {
     uint16_t dig_t1;
     int16_t dig_t2;
@@ -61,12 +114,78 @@ struct bmp280_calib_param {
     int16_t dig_p9;
 };
 
+// Dispositivo: calibração lida uma vez e t_fine da última temperatura
+// compensada, reaproveitado pela compensação de pressão da mesma amostra
+typedef struct {
+    i2c_inst_t *i2c;
+    struct bmp280_calib_param calib;
+    int32_t t_fine;
+
+    const bmp280_config_t *config;
+    uint8_t ctrl_meas;             // Valores escritos, conferidos em cada leitura
+    uint8_t config_reg;
+    uint32_t measurement_us;       // Tempo máximo de conversão da configuração
+    absolute_time_t ready_at;      // Fim da conversão forçada em andamento
+
+    uint32_t busy_reads;           // Leituras com a conversão ainda em andamento
+    uint32_t reconfigs;            // Configuração perdida e reescrita
+
+    i2c_xfer_t xfer;               // Rajada por DMA do escalonador
+    uint8_t burst[BMP280_BURST_LEN];
+} bmp280_t;
+
 //void bmp280_init(void);
 void bmp280_init(i2c_inst_t *i2c);
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
 void bmp280_reset(i2c_inst_t *i2c);
 int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params);
 int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params);
 void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
 
+// Confere o ID do chip, guarda a calibração e aplica BMP280_PRESET_STANDARD;
+// false se o sensor não responder. Preserva busy_reads e reconfigs; dev deve
+// começar zerado (estático ou memset).
+bool bmp280_begin(bmp280_t *dev, i2c_inst_t *i2c);
+
+// Aplica uma configuração (o sensor passa pelo sleep para aceitar o filtro
+// e o standby) ou um dos perfis
+bool bmp280_configure(bmp280_t *dev, const bmp280_config_t *config);
+bool bmp280_set_preset(bmp280_t *dev, bmp280_preset_t preset);
+
+// Tempo máximo de conversão do datasheet para a sobreamostragem escolhida
+uint32_t bmp280_measurement_us(const bmp280_config_t *config);
+
+// Dispara uma conversão no modo forçado (no normal não faz nada); o
+// resultado fica pronto em dev->ready_at
+bool bmp280_trigger(bmp280_t *dev);
+
+// Lê status, controle e dados numa só transação. BMP280_BUSY se a conversão
+// forçada não terminou; se o controle lido não for o escrito (sensor
+// reiniciado), reescreve a configuração e retorna BMP280_ERROR.
+bmp280_status_t bmp280_read_burst(bmp280_t *dev, int32_t *temp, int32_t *pressure);
+
+// Mesmas conferências sobre uma rajada já lida (a partir de REG_STATUS)
+bmp280_status_t bmp280_parse_burst(bmp280_t *dev, const uint8_t buf[BMP280_BURST_LEN], int32_t *temp,
+                                   int32_t *pressure);
+
+// Temperatura em centésimos de grau; atualiza dev->t_fine
+int32_t bmp280_compensate_temp(bmp280_t *dev, int32_t raw_temp);
+
+// Pressão a partir do t_fine guardado (compensar a temperatura antes):
+// fórmula de 32 bits do datasheet, em Pa, ou a de 64 bits, em Pa Q24.8
+// (valor / 256; resolução de 1/256 Pa)
+uint32_t bmp280_compensate_pressure(const bmp280_t *dev, int32_t raw_pressure);
+uint32_t bmp280_compensate_pressure64(const bmp280_t *dev, int32_t raw_pressure);
+
+// Compensa n amostras cruas: temperatura em centésimos de grau e pressão em
+// Pa Q24.8 (caminho de 64 bits). dev->t_fine fica com o da última amostra.
+void bmp280_compensate_batch(bmp280_t *dev, const int32_t *raw_temp, const int32_t *raw_pressure,
+                             int32_t *temp, uint32_t *pressure, size_t n);
+
+// Sensor para o escalonador (ctx: bmp280_t): BMP_Temp em centésimos de grau e
+// Pressao em Pa. Nos perfis de modo forçado cada amostra do escalonador dispara
+// uma conversão; no modo normal a leitura pega a última conversão contínua.
+// A rajada vem por DMA (i2c_async), pedida quando a conversão termina.
+extern const sensor_driver_t bmp280_sensor;
+
 #endif
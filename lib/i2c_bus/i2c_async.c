@@ -0,0 +1,179 @@
+#include "i2c_async.h"
+#include "hardware/dma.h"
+
+#define I2C_ASYNC_NUM_PORTS 2
+
+typedef struct {
+    bool claimed;              // Canais já pedidos (mesmo que sem sucesso)
+    int tx_chan;               // -1: sem DMA neste barramento
+    int rx_chan;
+    i2c_xfer_t *head;          // Descritor em andamento, seguido dos pendentes
+    i2c_xfer_t *tail;
+    uint64_t deadline_us;      // Timeout do descritor em andamento
+    uint16_t cmd[1 + I2C_XFER_MAX_LEN];  // Palavras de IC_DATA_CMD do descritor em andamento
+} i2c_async_port_t;
+
+static i2c_async_port_t ports[I2C_ASYNC_NUM_PORTS];
+static i2c_async_stats_t stats;
+
+static i2c_async_port_t *port_of(i2c_inst_t *i2c)
+{
+    return &ports[i2c_hw_index(i2c)];
+}
+
+static bool claim_channels(i2c_async_port_t *port)
+{
+    if (!port->claimed) {
+        port->claimed = true;
+        port->tx_chan = dma_claim_unused_channel(false);
+        port->rx_chan = port->tx_chan >= 0 ? dma_claim_unused_channel(false) : -1;
+        if (port->rx_chan < 0 && port->tx_chan >= 0) {
+            dma_channel_unclaim(port->tx_chan);
+            port->tx_chan = -1;
+        }
+    }
+    return port->rx_chan >= 0;
+}
+
+static void finish(i2c_xfer_t *xfer, bool ok)
+{
+    if (ok) {
+        stats.bytes += xfer->len;
+    } else {
+        stats.failures++;
+    }
+    xfer->status = ok ? I2C_XFER_DONE : I2C_XFER_FAILED;
+    if (xfer->done)
+        xfer->done(xfer);
+}
+
+// Endereço do registrador, RESTART e len comandos de leitura, o último com
+// STOP. O DMA de recepção é armado antes: o primeiro byte chega logo após o
+// último comando entrar no FIFO.
+static void start(i2c_async_port_t *port, i2c_xfer_t *xfer)
+{
+    const i2c_dev_t *dev = i2c_dev_get(xfer->dev);
+    i2c_inst_t *i2c = dev->bus->hw_inst;
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+
+    hw->enable = 0;
+    hw->tar = dev->address;
+    hw->enable = 1;
+    (void)hw->clr_tx_abrt;
+
+    port->cmd[0] = xfer->reg;
+    for (uint8_t i = 1; i <= xfer->len; ++i)
+        port->cmd[i] = I2C_IC_DATA_CMD_CMD_BITS;
+    port->cmd[1] |= I2C_IC_DATA_CMD_RESTART_BITS;
+    port->cmd[xfer->len] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    dma_channel_config rx = dma_channel_get_default_config(port->rx_chan);
+    channel_config_set_transfer_data_size(&rx, DMA_SIZE_8);
+    channel_config_set_read_increment(&rx, false);
+    channel_config_set_write_increment(&rx, true);
+    channel_config_set_dreq(&rx, i2c_get_dreq(i2c, false));
+    dma_channel_configure(port->rx_chan, &rx, xfer->dst, &hw->data_cmd, xfer->len, true);
+
+    dma_channel_config tx = dma_channel_get_default_config(port->tx_chan);
+    channel_config_set_transfer_data_size(&tx, DMA_SIZE_16);
+    channel_config_set_read_increment(&tx, true);
+    channel_config_set_write_increment(&tx, false);
+    channel_config_set_dreq(&tx, i2c_get_dreq(i2c, true));
+    dma_channel_configure(port->tx_chan, &tx, &hw->data_cmd, port->cmd, xfer->len + 1u, true);
+
+    // Escrita do registrador + leitura, com a mesma folga das transações bloqueantes
+    port->deadline_us = time_us_64() + i2c_bus_timeout_us(i2c, 1) + i2c_bus_timeout_us(i2c, xfer->len);
+    xfer->status = I2C_XFER_ACTIVE;
+}
+
+// Conclui o descritor em andamento, se terminou, e já inicia o próximo antes
+// do callback para o barramento não ficar parado
+static bool poll_port(i2c_async_port_t *port)
+{
+    i2c_xfer_t *xfer = port->head;
+    if (!xfer)
+        return false;
+
+    i2c_inst_t *i2c = i2c_dev_port(xfer->dev);
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    bool ok = true;
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // NACK: o controlador descarta os comandos e a recepção nunca termina
+        dma_channel_abort(port->tx_chan);
+        dma_channel_abort(port->rx_chan);
+        (void)hw->clr_tx_abrt;
+        i2c_bus_fall_back(i2c);  // Acima do fast mode, os próximos vão em 400 kHz
+        ok = false;
+    } else if (dma_channel_is_busy(port->rx_chan)) {
+        if (time_us_64() < port->deadline_us)
+            return true;
+        // Barramento preso (SDA baixo): os bytes não chegam nem com abort
+        dma_channel_abort(port->tx_chan);
+        dma_channel_abort(port->rx_chan);
+        stats.timeouts++;
+        i2c_bus_of(i2c)->timeouts++;
+        i2c_bus_recover(i2c);
+        ok = false;
+    } else {
+        stats.transfers++;
+    }
+
+    port->head = xfer->next;
+    if (!port->head)
+        port->tail = NULL;
+    xfer->next = NULL;
+    if (port->head)
+        start(port, port->head);
+
+    finish(xfer, ok);
+    return port->head != NULL;
+}
+
+bool i2c_async_submit(i2c_xfer_t *xfer)
+{
+    if (!xfer->dst || xfer->len == 0 || xfer->len > I2C_XFER_MAX_LEN || i2c_xfer_pending(xfer))
+        return false;
+
+    i2c_inst_t *i2c = i2c_dev_port(xfer->dev);
+    i2c_async_port_t *port = port_of(i2c);
+    xfer->next = NULL;
+
+    if (!claim_channels(port)) {
+        uint8_t addr = i2c_dev_get(xfer->dev)->address;
+        stats.blocking++;
+        finish(xfer, i2c_bus_write(i2c, addr, &xfer->reg, 1, true) == 1 &&
+                     i2c_bus_read(i2c, addr, xfer->dst, xfer->len, false) == xfer->len);
+        return true;
+    }
+
+    xfer->status = I2C_XFER_QUEUED;
+    if (port->tail) {
+        port->tail->next = xfer;
+    } else {
+        port->head = xfer;
+    }
+    port->tail = xfer;
+    if (port->head == xfer)
+        start(port, xfer);
+    return true;
+}
+
+void i2c_async_poll()
+{
+    for (int i = 0; i < I2C_ASYNC_NUM_PORTS; ++i)
+        poll_port(&ports[i]);
+}
+
+// Espera ativa: cada passo cobre pouco mais de um byte a 400 kHz
+void i2c_async_flush(i2c_inst_t *i2c)
+{
+    i2c_async_port_t *port = port_of(i2c);
+
+    while (poll_port(port))
+        busy_wait_us(25);
+}
+
+const i2c_async_stats_t *i2c_async_get_stats()
+{
+    return &stats;
+}
@@ -0,0 +1,72 @@
+#ifndef I2C_ASYNC_H
+#define I2C_ASYNC_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+#include "i2c_bus.h"
+
+// Leituras de registradores por DMA. Cada descritor pede len bytes a partir
+// de reg de um dispositivo da tabela (config/i2c_config.c); os descritores de
+// um barramento formam uma fila executada em sequência: um canal de DMA envia
+// o endereço do registrador e os comandos de leitura para IC_DATA_CMD e outro
+// traz os bytes recebidos para dst. A CPU só monta a fila e colhe o resultado
+// em i2c_async_poll().
+
+#define I2C_XFER_MAX_LEN 32
+
+typedef enum {
+    I2C_XFER_IDLE,       // Fora da fila; o dono pode reenviá-lo
+    I2C_XFER_QUEUED,
+    I2C_XFER_ACTIVE,     // No barramento
+    I2C_XFER_DONE,       // Bytes em dst
+    I2C_XFER_FAILED      // NACK do dispositivo ou timeout
+} i2c_xfer_status_t;
+
+typedef struct i2c_xfer i2c_xfer_t;
+typedef void (*i2c_xfer_cb_t)(i2c_xfer_t *xfer);
+
+struct i2c_xfer {
+    i2c_dev_id_t dev;
+    uint8_t reg;
+    uint8_t len;               // 1..I2C_XFER_MAX_LEN
+    uint8_t *dst;
+    i2c_xfer_cb_t done;        // Chamado ao concluir (com sucesso ou não); opcional
+    void *ctx;
+
+    volatile i2c_xfer_status_t status;
+    i2c_xfer_t *next;          // Uso interno da fila
+};
+
+typedef struct {
+    uint32_t transfers;        // Descritores concluídos por DMA
+    uint32_t bytes;
+    uint32_t failures;
+    uint32_t timeouts;         // Falhas por barramento preso (seguidas de i2c_bus_recover())
+    uint32_t blocking;         // Executados sem DMA (nenhum canal livre)
+} i2c_async_stats_t;
+
+static inline bool i2c_xfer_pending(const i2c_xfer_t *xfer) {
+    return xfer->status == I2C_XFER_QUEUED || xfer->status == I2C_XFER_ACTIVE;
+}
+
+// Põe o descritor na fila do barramento do dispositivo; começa na hora se o
+// barramento estiver livre. Os dois canais de DMA de um barramento são
+// reservados no primeiro envio; sem canais, a leitura é feita na hora, de
+// forma bloqueante. Retorna false para descritor inválido ou ainda na fila.
+bool i2c_async_submit(i2c_xfer_t *xfer);
+
+// Conclui os descritores cujo DMA terminou, inicia os seguintes e chama os
+// callbacks. Chamar periodicamente (os drivers chamam em ready()). Um
+// descritor que não termina no timeout do barramento falha e o barramento é
+// recuperado.
+void i2c_async_poll();
+
+// Espera a fila do barramento esvaziar. Chamar antes de qualquer transação
+// bloqueante no mesmo barramento: o controlador só atende um de cada vez.
+void i2c_async_flush(i2c_inst_t *i2c);
+
+const i2c_async_stats_t *i2c_async_get_stats();
+
+#endif // I2C_ASYNC_H
@@ -0,0 +1,234 @@
+#include <stdio.h>
+#include <string.h>
+#include "i2c_bus.h"
+
+static bool measuring;
+
+i2c_inst_t *i2c_dev_port(i2c_dev_id_t id)
+{
+    return i2c_dev_get(id)->bus->hw_inst;
+}
+
+i2c_bus_t *i2c_bus_of(i2c_inst_t *i2c)
+{
+    for (size_t b = 0; b < i2c_bus_get_num(); ++b) {
+        i2c_bus_t *bus = i2c_bus_get_by_num(b);
+        if (bus->hw_inst == i2c)
+            return bus;
+    }
+    return NULL;
+}
+
+uint i2c_bus_target_baud(const i2c_bus_t *bus)
+{
+    uint baud = bus->baud_rate;
+
+    for (int d = 0; d < I2C_NUM_DEVICES; ++d) {
+        const i2c_dev_t *dev = i2c_dev_get((i2c_dev_id_t)d);
+        if (dev->bus == bus && dev->max_baud_rate && dev->max_baud_rate < baud)
+            baud = dev->max_baud_rate;
+    }
+    return baud;
+}
+
+void i2c_bus_init(i2c_bus_t *bus)
+{
+    if (bus->initialized)
+        return;
+
+    bus->actual_baud_rate = i2c_init(bus->hw_inst, i2c_bus_target_baud(bus));
+    gpio_set_function(bus->sda_gpio, GPIO_FUNC_I2C);
+    gpio_set_function(bus->scl_gpio, GPIO_FUNC_I2C);
+    if (bus->internal_pull_up) {
+        gpio_pull_up(bus->sda_gpio);
+        gpio_pull_up(bus->scl_gpio);
+    }
+    bus->initialized = true;
+}
+
+bool i2c_bus_fall_back(i2c_inst_t *i2c)
+{
+    i2c_bus_t *bus = i2c_bus_of(i2c);
+
+    if (!bus || bus->actual_baud_rate <= I2C_BAUD_FAST)
+        return false;
+    bus->actual_baud_rate = i2c_set_baudrate(i2c, I2C_BAUD_FAST);
+    bus->stats.fallbacks++;
+    return true;
+}
+
+// START + endereço + len bytes, 9 bits cada, + STOP, com folga
+uint i2c_bus_timeout_us(i2c_inst_t *i2c, size_t len)
+{
+    const i2c_bus_t *bus = i2c_bus_of(i2c);
+    uint baud = bus && bus->actual_baud_rate ? bus->actual_baud_rate : I2C_BAUD_STANDARD;
+    uint64_t bits = 9ull * (len + 1) + 2;
+    return (uint)(bits * 1000000ull / baud) + I2C_BUS_TIMEOUT_MARGIN_US;
+}
+
+static int i2c_bus_transfer(i2c_inst_t *i2c, uint8_t addr, uint8_t *buf, size_t len, bool nostop, bool read)
+{
+    i2c_bus_t *bus = i2c_bus_of(i2c);
+    int ret;
+
+    do {
+        uint timeout = i2c_bus_timeout_us(i2c, len);
+        uint64_t start = measuring ? time_us_64() : 0;
+        ret = read ? i2c_read_timeout_us(i2c, addr, buf, len, nostop, timeout)
+                   : i2c_write_timeout_us(i2c, addr, buf, len, nostop, timeout);
+        if (!bus)
+            return ret;
+
+        bus->stats.transactions++;
+        if (measuring) {
+            uint32_t us = (uint32_t)(time_us_64() - start);
+            bus->stats.busy_us += us;
+            bus->stats.timed++;
+            if (us > bus->stats.max_us)
+                bus->stats.max_us = us;
+        }
+        if (ret == (int)len) {
+            bus->stats.bytes += len;
+            break;
+        }
+        bus->stats.errors++;
+        if (ret == PICO_ERROR_TIMEOUT)
+            bus->timeouts++;
+    } while (i2c_bus_fall_back(i2c));
+
+    if (ret == PICO_ERROR_TIMEOUT)
+        i2c_bus_recover(i2c);
+    return ret;
+}
+
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop)
+{
+    return i2c_bus_transfer(i2c, addr, (uint8_t *)src, len, nostop, false);
+}
+
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop)
+{
+    return i2c_bus_transfer(i2c, addr, dst, len, nostop, true);
+}
+
+bool i2c_bus_recover(i2c_inst_t *i2c)
+{
+    i2c_bus_t *bus = i2c_bus_of(i2c);
+
+    if (!bus || !bus->initialized)
+        return false;
+
+    // Pinos como GPIO: SDA solto (pull-up) e SCL em nível alto
+    i2c_deinit(i2c);
+    gpio_init(bus->sda_gpio);
+    gpio_init(bus->scl_gpio);
+    gpio_put(bus->scl_gpio, true);
+    gpio_set_dir(bus->scl_gpio, GPIO_OUT);
+
+    // Cada pulso deixa o escravo terminar um bit do byte interrompido; quando
+    // ele solta SDA, o pulso seguinte fica sem ACK e ele volta ao repouso
+    for (int i = 0; i < I2C_BUS_CLEAR_PULSES && !gpio_get(bus->sda_gpio); ++i) {
+        gpio_put(bus->scl_gpio, false);
+        busy_wait_us(I2C_BUS_CLEAR_HALF_US);
+        gpio_put(bus->scl_gpio, true);
+        busy_wait_us(I2C_BUS_CLEAR_HALF_US);
+    }
+    bool released = gpio_get(bus->sda_gpio);
+
+    // STOP: SDA sobe com SCL alto (SDA em dreno aberto: só é puxado para baixo)
+    gpio_put(bus->sda_gpio, false);
+    gpio_set_dir(bus->sda_gpio, GPIO_OUT);
+    busy_wait_us(I2C_BUS_CLEAR_HALF_US);
+    gpio_set_dir(bus->sda_gpio, GPIO_IN);
+    busy_wait_us(I2C_BUS_CLEAR_HALF_US);
+
+    bus->actual_baud_rate = i2c_init(i2c, bus->actual_baud_rate);
+    gpio_set_function(bus->sda_gpio, GPIO_FUNC_I2C);
+    gpio_set_function(bus->scl_gpio, GPIO_FUNC_I2C);
+    bus->recoveries++;
+    return released;
+}
+
+void i2c_bus_set_measure(bool enabled)
+{
+    if (enabled && !measuring) {
+        for (size_t b = 0; b < i2c_bus_get_num(); ++b)
+            memset(&i2c_bus_get_by_num(b)->stats, 0, sizeof(i2c_bus_stats_t));
+    }
+    measuring = enabled;
+}
+
+bool i2c_bus_measuring()
+{
+    return measuring;
+}
+
+void i2c_bus_print_stats()
+{
+    for (size_t b = 0; b < i2c_bus_get_num(); ++b) {
+        i2c_bus_t *bus = i2c_bus_get_by_num(b);
+        const i2c_bus_stats_t *st = &bus->stats;
+        printf("i2c%u a %u kHz: %lu transacoes, %lu bytes, %lu erros, %lu recuos de velocidade, "
+               "%lu recuperacoes desde o boot",
+               i2c_hw_index(bus->hw_inst), bus->actual_baud_rate / 1000, (unsigned long)st->transactions,
+               (unsigned long)st->bytes, (unsigned long)st->errors, (unsigned long)st->fallbacks,
+               (unsigned long)bus->recoveries);
+        if (st->timed)
+            printf("; media %lu us, max %lu us", (unsigned long)(st->busy_us / st->timed),
+                   (unsigned long)st->max_us);
+        printf("\n");
+        memset(&bus->stats, 0, sizeof(bus->stats));
+    }
+}
+
+size_t i2c_bus_format_health(char *dst, size_t size)
+{
+    int len = 0;
+
+    for (size_t b = 0; b < i2c_bus_get_num() && len >= 0 && (size_t)len < size; ++b) {
+        const i2c_bus_t *bus = i2c_bus_get_by_num(b);
+        len += snprintf(dst + len, size - len, "%si2c%u %lu timeouts %lu recuperacoes", b ? "," : "",
+                        i2c_hw_index(bus->hw_inst), (unsigned long)bus->timeouts,
+                        (unsigned long)bus->recoveries);
+    }
+    return len < 0 ? 0 : ((size_t)len < size ? (size_t)len : size - 1);
+}
+
+i2c_inst_t *i2c_dev_init(i2c_dev_id_t id)
+{
+    i2c_dev_t *dev = i2c_dev_get(id);
+
+    i2c_bus_init(dev->bus);
+    return dev->bus->hw_inst;
+}
+
+void i2c_bus_print_map()
+{
+    for (size_t b = 0; b < i2c_bus_get_num(); ++b) {
+        const i2c_bus_t *bus = i2c_bus_get_by_num(b);
+        printf("i2c%u (SDA %u, SCL %u, %u kHz):", i2c_hw_index(bus->hw_inst), bus->sda_gpio,
+               bus->scl_gpio, (bus->initialized ? bus->actual_baud_rate : i2c_bus_target_baud(bus)) / 1000);
+        for (int d = 0; d < I2C_NUM_DEVICES; ++d) {
+            const i2c_dev_t *dev = i2c_dev_get((i2c_dev_id_t)d);
+            if (dev->bus == bus)
+                printf(" %s@0x%02X (ate %u kHz)", dev->name, dev->address, dev->max_baud_rate / 1000);
+        }
+        printf("\n");
+    }
+}
+
+bool i2c_bus_check_config()
+{
+    const i2c_dev_t *display = i2c_dev_get(I2C_DEV_SSD1306);
+    bool ok = true;
+
+    for (int d = 0; d < I2C_NUM_DEVICES; ++d) {
+        const i2c_dev_t *dev = i2c_dev_get((i2c_dev_id_t)d);
+        if (dev != display && dev->bus == display->bus) {
+            printf("Erro: %s e %s no mesmo barramento I2C (i2c%u)\n", display->name, dev->name,
+                   i2c_hw_index(dev->bus->hw_inst));
+            ok = false;
+        }
+    }
+    return ok;
+}
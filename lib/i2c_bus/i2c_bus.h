@@ -0,0 +1,140 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+// Gerenciador dos barramentos I2C. A distribuição dos dispositivos entre
+// i2c0 e i2c1 (pinos, velocidade e endereço) vem da tabela em
+// config/i2c_config.c, como a configuração do SPI em config/hw_config.c;
+// os drivers pedem a porta pelo identificador do dispositivo.
+//
+// Cada dispositivo declara a velocidade máxima que aceita; o barramento roda
+// na menor entre a pedida para ele e a de cada dispositivo ligado. Acima do
+// fast mode, um NACK ou timeout faz o barramento recuar para 400 kHz e a
+// transação é repetida (i2c_bus_write()/i2c_bus_read()).
+//
+// Toda transação tem timeout. Um escravo que perdeu a sincronia (reset ou
+// ruído no meio de um byte) pode segurar SDA em nível baixo indefinidamente;
+// depois de um timeout o barramento é liberado com pulsos em SCL e o
+// controlador é reiniciado (i2c_bus_recover()). Um NACK não dispara a
+// recuperação: é o caso de um dispositivo ausente, não de um barramento preso.
+
+#define I2C_BAUD_STANDARD  (100 * 1000)
+#define I2C_BAUD_FAST      (400 * 1000)
+#define I2C_BAUD_FAST_PLUS (1000 * 1000)  // Fm+: pede pull-ups externos fortes (~2,2 kΩ)
+
+// Folga do timeout de uma transação sobre o tempo dos bits, para o clock
+// stretching dos sensores
+#define I2C_BUS_TIMEOUT_MARGIN_US 1000
+
+// Pulsos de SCL (um byte e o ACK) e meio período deles (100 kHz) na
+// liberação de SDA
+#define I2C_BUS_CLEAR_PULSES 9
+#define I2C_BUS_CLEAR_HALF_US 5
+
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+    uint32_t errors;          // NACKs e timeouts
+    uint32_t fallbacks;       // Recuos de velocidade
+    uint64_t busy_us;         // Duração das transações no modo de medição
+    uint32_t max_us;
+    uint32_t timed;           // Transações medidas
+} i2c_bus_stats_t;
+
+typedef struct {
+    i2c_inst_t *hw_inst;      // Controlador I2C
+    uint sda_gpio;            // Número do GPIO (não do pino da placa)
+    uint scl_gpio;
+    uint baud_rate;           // Velocidade pedida; limitada pelos dispositivos
+    bool internal_pull_up;    // Pull-ups internos (fracos; resistores externos são melhores)
+
+    // Estado
+    uint actual_baud_rate;    // Retornado por i2c_init()/i2c_set_baudrate()
+    bool initialized;
+    i2c_bus_stats_t stats;    // Transações bloqueantes (i2c_bus_write()/i2c_bus_read())
+    uint32_t timeouts;        // Desde o boot (não zerados com as estatísticas)
+    uint32_t recoveries;
+} i2c_bus_t;
+
+typedef enum {
+    I2C_DEV_MPU6050,
+    I2C_DEV_BMP280,
+    I2C_DEV_AHT20,
+    I2C_DEV_SSD1306,
+    I2C_NUM_DEVICES
+} i2c_dev_id_t;
+
+typedef struct {
+    const char *name;
+    i2c_bus_t *bus;
+    uint8_t address;
+    uint max_baud_rate;       // Maior velocidade que o dispositivo aceita
+} i2c_dev_t;
+
+// Acesso à tabela de configuração (config/i2c_config.c)
+size_t i2c_bus_get_num();
+i2c_bus_t *i2c_bus_get_by_num(size_t num);
+i2c_dev_t *i2c_dev_get(i2c_dev_id_t id);
+
+// Porta I2C do dispositivo
+i2c_inst_t *i2c_dev_port(i2c_dev_id_t id);
+
+// Barramento de um controlador (NULL se não estiver na tabela)
+i2c_bus_t *i2c_bus_of(i2c_inst_t *i2c);
+
+// Configura pinos, pull-ups e velocidade do barramento; só na primeira chamada
+void i2c_bus_init(i2c_bus_t *bus);
+
+// Velocidade do barramento: a pedida, limitada pelos dispositivos ligados a ele
+uint i2c_bus_target_baud(const i2c_bus_t *bus);
+
+// Recua um barramento acima do fast mode para 400 kHz; false se já estava
+// em 400 kHz ou menos. Chamar só sem transação em andamento no barramento.
+bool i2c_bus_fall_back(i2c_inst_t *i2c);
+
+// Timeout de uma transação de len bytes na velocidade atual do barramento
+uint i2c_bus_timeout_us(i2c_inst_t *i2c, size_t len);
+
+// Transações bloqueantes com timeout proporcional ao tamanho, contadas nas
+// estatísticas do barramento e, numa falha acima do fast mode, repetidas em
+// 400 kHz. Retornam como i2c_write_blocking()/i2c_read_blocking(); um timeout
+// dispara i2c_bus_recover().
+int i2c_bus_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+int i2c_bus_read(i2c_inst_t *i2c, uint8_t addr, uint8_t *dst, size_t len, bool nostop);
+
+// Libera um barramento travado: com os pinos como GPIO, gera até
+// I2C_BUS_CLEAR_PULSES pulsos em SCL enquanto SDA estiver baixo e um STOP, e
+// reinicia o controlador na velocidade atual. Retorna false se SDA continuar
+// preso. Chamar só sem transação em andamento no barramento.
+bool i2c_bus_recover(i2c_inst_t *i2c);
+
+// Timeouts e recuperações de cada barramento desde o boot, em texto
+// ("i2c0 0 timeouts 0 recuperacoes,i2c1 ..."), para os registros de metadados
+size_t i2c_bus_format_health(char *dst, size_t size);
+
+// Modo de medição: cronometra cada transação bloqueante (desligado por padrão);
+// ao ligar, zera as estatísticas
+void i2c_bus_set_measure(bool enabled);
+bool i2c_bus_measuring();
+
+// Imprime velocidade e tempos medidos de cada barramento e zera as estatísticas
+void i2c_bus_print_stats();
+
+// Inicializa o barramento do dispositivo e retorna a sua porta
+i2c_inst_t *i2c_dev_init(i2c_dev_id_t id);
+
+// Imprime a distribuição dos dispositivos nos barramentos
+void i2c_bus_print_map();
+
+// Confere a tabela: o display precisa de um barramento só para ele. Os
+// quadros vão por DMA direto ao controlador (TAR e FIFO) sem arbitragem com
+// a fila de i2c_async nem com as transações bloqueantes dos sensores, e um
+// corromperia o outro. Imprime os conflitos e retorna false.
+bool i2c_bus_check_config();
+
+#endif // I2C_BUS_H
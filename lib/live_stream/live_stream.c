@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdio.h"
+#include "hardware/sync.h"
+#include "tusb.h"
+#include "live_stream.h"
+
+static char buffer[LIVE_STREAM_BUFFER_SIZE];
+static uint32_t head = 0;  // Próximo byte a escrever (contador livre)
+static uint32_t tail = 0;  // Próximo byte a enviar (contador livre)
+
+static uint32_t decimation = LIVE_STREAM_DEFAULT_DECIMATION;
+static uint32_t decimation_count = 0;
+
+static uint32_t tokens = LIVE_STREAM_BURST_BYTES;
+static uint64_t last_refill_us = 0;
+
+static live_stream_stats_t stats;
+
+void live_stream_init(uint32_t n)
+{
+    head = tail = 0;
+    memset(&stats, 0, sizeof(stats));
+    tokens = LIVE_STREAM_BURST_BYTES;
+    last_refill_us = time_us_64();
+    live_stream_set_decimation(n);
+}
+
+void live_stream_set_decimation(uint32_t n)
+{
+    decimation = n;
+    decimation_count = 0;
+}
+
+uint32_t live_stream_get_decimation()
+{
+    return decimation;
+}
+
+void live_stream_push_record(const char *record, size_t len)
+{
+    stats.offered++;
+
+    if (decimation == 0 || decimation_count++ % decimation != 0) {
+        stats.decimated++;
+        return;
+    }
+
+    // Registros são enfileirados inteiros ou descartados inteiros
+    if (len > LIVE_STREAM_BUFFER_SIZE - (head - tail)) {
+        stats.dropped++;
+        return;
+    }
+
+    uint32_t pos = head & (LIVE_STREAM_BUFFER_SIZE - 1);
+    uint32_t first = LIVE_STREAM_BUFFER_SIZE - pos;
+    if (first > len)
+        first = (uint32_t)len;
+    memcpy(&buffer[pos], record, first);
+    memcpy(buffer, record + first, len - first);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    head += (uint32_t)len;
+    restore_interrupts(irq_state);
+    stats.queued++;
+}
+
+// Balde de tokens: LIVE_STREAM_MAX_BYTES_PER_S, com acúmulo limitado
+static void refill_tokens()
+{
+    uint64_t now = time_us_64();
+    uint64_t earned = (now - last_refill_us) * LIVE_STREAM_MAX_BYTES_PER_S / 1000000;
+    if (earned == 0)
+        return;
+
+    last_refill_us = now;
+    tokens = (uint32_t)((tokens + earned > LIVE_STREAM_BURST_BYTES) ? LIVE_STREAM_BURST_BYTES : tokens + earned);
+}
+
+void live_stream_poll()
+{
+    refill_tokens();
+
+    if (head == tail || tokens == 0 || !tud_cdc_connected())
+        return;
+
+    // O envio passa pelo stdio do SDK, que serializa com o printf() e com o
+    // tud_task() em segundo plano (mutex do stdio USB); o limite pelo espaço
+    // livre no FIFO do CDC faz a escrita nunca esperar pelo host
+    uint32_t budget = tud_cdc_write_available();
+    if (budget > tokens)
+        budget = tokens;
+
+    uint32_t sent = 0;
+    uint32_t end = head;
+    while (sent < budget && end != tail) {
+        uint32_t pos = tail & (LIVE_STREAM_BUFFER_SIZE - 1);
+        uint32_t chunk = LIVE_STREAM_BUFFER_SIZE - pos;
+        if (chunk > end - tail)
+            chunk = end - tail;
+        if (chunk > budget - sent)
+            chunk = budget - sent;
+
+        stdio_put_string(&buffer[pos], (int)chunk, false, false);
+
+        uint32_t irq_state = save_and_disable_interrupts();
+        tail += chunk;
+        restore_interrupts(irq_state);
+        sent += chunk;
+    }
+
+    tokens -= sent;
+    stats.bytes_sent += sent;
+}
+
+const live_stream_stats_t *live_stream_get_stats()
+{
+    return &stats;
+}
+
+void live_stream_print_stats()
+{
+    printf("Stream ao vivo: decimacao 1/%lu, %lu registros, %lu enfileirados, %lu decimados, %lu perdidos, %llu bytes enviados\n",
+           (unsigned long)decimation, (unsigned long)stats.offered, (unsigned long)stats.queued,
+           (unsigned long)stats.decimated, (unsigned long)stats.dropped, (unsigned long long)stats.bytes_sent);
+}
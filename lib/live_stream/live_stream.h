@@ -0,0 +1,43 @@
+#ifndef LIVE_STREAM_H
+#define LIVE_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Canal de transmissão ao vivo dos registros pelo USB CDC, separado do laço de
+// captura: save_data() apenas enfileira o registro (ou o descarta, contando a
+// perda) e live_stream_poll() envia só o que cabe no FIFO do USB, limitado a
+// uma taxa máxima. O console nunca bloqueia a gravação no cartão.
+
+#define LIVE_STREAM_BUFFER_SIZE 1024          // Potência de 2
+#define LIVE_STREAM_MAX_BYTES_PER_S 4096      // Taxa máxima de envio
+#define LIVE_STREAM_BURST_BYTES 512           // Acúmulo máximo do balde de tokens
+#define LIVE_STREAM_DEFAULT_DECIMATION 1      // Envia 1 a cada N registros; 0 desliga
+
+typedef struct {
+    uint32_t offered;     // Registros recebidos por live_stream_push_record()
+    uint32_t decimated;   // Ignorados pela decimação
+    uint32_t dropped;     // Descartados por falta de espaço no buffer
+    uint32_t queued;      // Enfileirados para envio
+    uint64_t bytes_sent;  // Bytes entregues ao USB CDC
+} live_stream_stats_t;
+
+// Inicializa o canal com a decimação indicada
+void live_stream_init(uint32_t decimation);
+
+// Altera a decimação (1 = todos os registros, N = um a cada N, 0 = desligado)
+void live_stream_set_decimation(uint32_t decimation);
+uint32_t live_stream_get_decimation();
+
+// Enfileira um registro completo; nunca bloqueia
+void live_stream_push_record(const char *record, size_t len);
+
+// Envia ao USB o que couber no FIFO e na taxa permitida; chamar no laço principal
+void live_stream_poll();
+
+const live_stream_stats_t *live_stream_get_stats();
+void live_stream_print_stats();
+
+#endif // LIVE_STREAM_H
@@ -3,14 +3,9 @@
 // Função para resetar e inicializar o MPU6050
 void mpu6050_init()
 {
-    // Configura o I2C
-    i2c_init(MPU_6050_I2C_PORT, 400 * 1000); // 400 kHz
-    gpio_set_function(MPU_6050_I2C_SDA, GPIO_FUNC_I2C);
-    gpio_set_function(MPU_6050_I2C_SCL, GPIO_FUNC_I2C);
-    gpio_pull_up(MPU_6050_I2C_SDA);
-    gpio_pull_up(MPU_6050_I2C_SCL);
-
-    bi_decl(bi_2pins_with_func(MPU_6050_I2C_SDA, MPU_6050_I2C_SCL, GPIO_FUNC_I2C));
+    // Configura o barramento I2C do sensor
+    i2c_dev_init(I2C_DEV_MPU6050);
+
     // Reseta e inicializa o MPU6050
     mpu6050_reset();
 }
@@ -21,24 +16,45 @@ void mpu6050_reset()
 {
     // Dois bytes para reset: primeiro o registrador, segundo o dado
     uint8_t buf[] = {0x6B, 0x80};
-    i2c_write_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, buf, 2, false);
+    i2c_bus_write(MPU_6050_I2C_PORT, MPU6050_ADDR, buf, 2, false);
     sleep_ms(100); // Aguarda reset e estabilização
 
     // Sai do modo sleep (registrador 0x6B, valor 0x00)
     buf[1] = 0x00;
-    i2c_write_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, buf, 2, false);
+    i2c_bus_write(MPU_6050_I2C_PORT, MPU6050_ADDR, buf, 2, false);
     sleep_ms(10); // Aguarda estabilização após acordar
 }
 
+// Confere o WHO_AM_I e acorda o sensor; a fila de DMA do barramento é
+// esvaziada antes (a leitura em andamento pode ser a que falhou)
+bool mpu6050_self_test()
+{
+    uint8_t reg = MPU6050_REG_WHO_AM_I, id = 0;
+    uint8_t wake[] = {MPU6050_REG_PWR_MGMT_1, 0x00};
+
+    i2c_async_flush(MPU_6050_I2C_PORT);
+    if (i2c_bus_write(MPU_6050_I2C_PORT, MPU6050_ADDR, &reg, 1, true) != 1 ||
+        i2c_bus_read(MPU_6050_I2C_PORT, MPU6050_ADDR, &id, 1, false) != 1 || id != MPU6050_WHO_AM_I)
+        return false;
+    return i2c_bus_write(MPU_6050_I2C_PORT, MPU6050_ADDR, wake, 2, false) == 2;
+}
+
+// Lê len bytes a partir de reg
+static bool mpu6050_read_regs(uint8_t reg, uint8_t *buffer, size_t len)
+{
+    return i2c_bus_write(MPU_6050_I2C_PORT, MPU6050_ADDR, &reg, 1, true) == 1 &&
+           i2c_bus_read(MPU_6050_I2C_PORT, MPU6050_ADDR, buffer, len, false) == (int)len;
+}
+
 // Função para ler dados crus do acelerômetro, giroscópio e temperatura
-void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp)
+bool mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp)
 {
     uint8_t buffer[6];
+    i2c_async_flush(MPU_6050_I2C_PORT);
 
     // Lê aceleração a partir do registrador 0x3B (6 bytes)
-    uint8_t val = 0x3B;
-    i2c_write_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, &val, 1, true);
-    i2c_read_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, buffer, 6, false);
+    if (!mpu6050_read_regs(0x3B, buffer, 6))
+        return false;
 
     for (int i = 0; i < 3; i++)
     {
@@ -46,9 +62,8 @@ void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp)
     }
 
     // Lê giroscópio a partir do registrador 0x43 (6 bytes)
-    val = 0x43;
-    i2c_write_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, &val, 1, true);
-    i2c_read_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, buffer, 6, false);
+    if (!mpu6050_read_regs(0x43, buffer, 6))
+        return false;
 
     for (int i = 0; i < 3; i++)
     {
@@ -56,9 +71,84 @@ void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp)
     }
 
     // Lê temperatura a partir do registrador 0x41 (2 bytes)
-    val = 0x41;
-    i2c_write_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, &val, 1, true);
-    i2c_read_blocking(MPU_6050_I2C_PORT, MPU6050_ADDR, buffer, 2, false);
+    if (!mpu6050_read_regs(0x41, buffer, 2))
+        return false;
 
     *temp = (buffer[0] << 8) | buffer[1];
+    return true;
+}
+
+int32_t mpu6050_temp_centi_celsius(int16_t temp_raw)
+{
+    // 100 * (raw / 340 + 36,53) = (100 * raw + 3653 * 340) / 340
+    int32_t num = (int32_t)temp_raw * 100 + 3653 * 340;
+    return num >= 0 ? (num + 170) / 340 : -((-num + 170) / 340);
+}
+
+// ---------------------------------------------------------------------------
+// Interface de sensor
+// ---------------------------------------------------------------------------
+
+static const sensor_channel_t mpu6050_channels[] = {
+    {"Acel_X", 0}, {"Acel_Y", 0}, {"Acel_Z", 0},
+    {"Gyro_X", 0}, {"Gyro_Y", 0}, {"Gyro_Z", 0},
+    {"Temp", 2},
+};
+
+// ACCEL_XOUT_H..GYRO_ZOUT_L: aceleração, temperatura e giroscópio em
+// sequência, trazidos por DMA direto para a amostra crua do sensor
+static i2c_xfer_t mpu6050_xfer = {
+    .dev = I2C_DEV_MPU6050,
+    .reg = 0x3B,
+    .len = 14,
+};
+
+static bool mpu6050_sensor_init(sensor_t *s)
+{
+    (void)s;
+    return mpu6050_self_test();
+}
+
+static bool mpu6050_sensor_start(sensor_t *s)
+{
+    mpu6050_xfer.dst = s->raw;
+    return i2c_async_submit(&mpu6050_xfer);
+}
+
+static bool mpu6050_sensor_ready(sensor_t *s)
+{
+    (void)s;
+    i2c_async_poll();
+    return !i2c_xfer_pending(&mpu6050_xfer);
+}
+
+static bool mpu6050_sensor_read(sensor_t *s, uint8_t *raw)
+{
+    (void)s;
+    (void)raw;  // Já preenchido pelo DMA
+    return mpu6050_xfer.status == I2C_XFER_DONE;
+}
+
+static void mpu6050_sensor_decode(sensor_t *s, const uint8_t *raw, int32_t *values)
+{
+    (void)s;
+
+    for (int i = 0; i < 3; i++) {
+        values[i] = (int16_t)((raw[i * 2] << 8) | raw[i * 2 + 1]);
+        values[3 + i] = (int16_t)((raw[8 + i * 2] << 8) | raw[8 + i * 2 + 1]);
+    }
+    values[6] = mpu6050_temp_centi_celsius((int16_t)((raw[6] << 8) | raw[7]));
 }
+
+const sensor_driver_t mpu6050_sensor = {
+    .name = "MPU6050",
+    .channels = mpu6050_channels,
+    .num_channels = 7,
+    .period_us = 500000,
+    .conversion_us = 0,
+    .init = mpu6050_sensor_init,
+    .start = mpu6050_sensor_start,
+    .ready = mpu6050_sensor_ready,
+    .read = mpu6050_sensor_read,
+    .decode = mpu6050_sensor_decode,
+};
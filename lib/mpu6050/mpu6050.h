@@ -5,23 +5,45 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "pico/binary_info.h"
+#include "sensor/sensor.h"
+#include "i2c_bus/i2c_bus.h"
+#include "i2c_bus/i2c_async.h"
 
-// Definição dos pinos I2C para o MPU6050
-#define MPU_6050_I2C_PORT i2c0                 // I2C0 usa pinos 0 e 1
-#define MPU_6050_I2C_SDA 0
-#define MPU_6050_I2C_SCL 1
+// Barramento do MPU6050 (pinos e velocidade em config/i2c_config.c)
+#define MPU_6050_I2C_PORT i2c_dev_port(I2C_DEV_MPU6050)
 
 // Endereço I2C do MPU6050
 #define MPU6050_ADDR 0x68
 
+// Registradores usados na verificação do sensor
+#define MPU6050_REG_PWR_MGMT_1 0x6B
+#define MPU6050_REG_WHO_AM_I   0x75
+#define MPU6050_WHO_AM_I       0x68
+
 // Função para resetar e inicializar o MPU6050
 void mpu6050_init();
 
 // Função para resetar e inicializar o MPU6050
 void mpu6050_reset();
 
-// Função para ler dados crus do acelerômetro, giroscópio e temperatura
-void mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp);
+// Verifica o sensor sem bloquear: WHO_AM_I deve responder 0x68; então o tira
+// do modo sleep (o estado após energizar), sem reset. Retorna false se o
+// sensor não responder ou não for um MPU6050.
+bool mpu6050_self_test();
+
+// Função para ler dados crus do acelerômetro, giroscópio e temperatura;
+// retorna false se alguma transação falhar (valores não atualizados)
+bool mpu6050_read_raw(int16_t accel[3], int16_t gyro[3], int16_t *temp);
+
+// Converte o valor cru de temperatura do MPU6050 para centésimos de grau
+// Celsius (raw / 340 + 36,53), arredondando a metade para longe do zero
+int32_t mpu6050_temp_centi_celsius(int16_t temp_raw);
+
+// Sensor para o escalonador: Acel_X..Gyro_Z crus e Temp em centésimos de grau,
+// lidos numa única rajada de 14 bytes a partir de ACCEL_XOUT_H, por DMA
+// (i2c_async): start() põe a leitura na fila e ready() espera o fim dela.
+// init() é mpu6050_self_test(), repetida pelo escalonador após falhas seguidas.
+extern const sensor_driver_t mpu6050_sensor;
 
 
 #endif // MPU6050_H
@@ -0,0 +1,118 @@
+#include "csv_record.h"
+#include "mpu6050/mpu6050.h"
+
+// Escreve exatamente n dígitos decimais de value (com zeros à esquerda)
+static inline char *put_fixed(char *p, uint32_t value, int n)
+{
+    for (int i = n - 1; i >= 0; --i) {
+        p[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    return p + n;
+}
+
+// Escreve um inteiro com sinal, sem zeros à esquerda
+static inline char *put_int(char *p, int32_t value)
+{
+    char tmp[10];
+    int n = 0;
+    uint32_t u;
+
+    if (value < 0) {
+        *p++ = '-';
+        u = (uint32_t)(-(int64_t)value);
+    } else {
+        u = (uint32_t)value;
+    }
+
+    do {
+        tmp[n++] = (char)('0' + u % 10);
+        u /= 10;
+    } while (u);
+
+    while (n)
+        *p++ = tmp[--n];
+    return p;
+}
+
+// "YYYY-MM-DD,HH:MM:SS"; sem RTC usa "0000-00-00,00:00:00"
+static char *put_timestamp(char *p, const datetime_t *dt)
+{
+    if (dt) {
+        p = put_fixed(p, (uint32_t)dt->year, 4);
+        *p++ = '-';
+        p = put_fixed(p, (uint32_t)dt->month, 2);
+        *p++ = '-';
+        p = put_fixed(p, (uint32_t)dt->day, 2);
+        *p++ = ',';
+        p = put_fixed(p, (uint32_t)dt->hour, 2);
+        *p++ = ':';
+        p = put_fixed(p, (uint32_t)dt->min, 2);
+        *p++ = ':';
+        p = put_fixed(p, (uint32_t)dt->sec, 2);
+    } else {
+        static const char fallback[] = "0000-00-00,00:00:00";
+        for (size_t i = 0; i < sizeof(fallback) - 1; ++i)
+            *p++ = fallback[i];
+    }
+    return p;
+}
+
+// Valor em ponto fixo com decimals casas: "-12.34" para (-1234, 2)
+static char *put_decimal(char *p, int32_t value, uint8_t decimals)
+{
+    static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+
+    if (decimals == 0)
+        return put_int(p, value);
+
+    uint32_t u = value < 0 ? (uint32_t)(-(int64_t)value) : (uint32_t)value;
+    if (value < 0)
+        *p++ = '-';
+    p = put_int(p, (int32_t)(u / pow10[decimals]));
+    *p++ = '.';
+    return put_fixed(p, u % pow10[decimals], decimals);
+}
+
+size_t csv_format_record(char *dst, const datetime_t *dt, const int16_t accel[3],
+                         const int16_t gyro[3], int16_t temp_raw)
+{
+    char *p = put_timestamp(dst, dt);
+
+    for (int i = 0; i < 3; ++i) {
+        *p++ = ',';
+        p = put_int(p, accel[i]);
+    }
+    for (int i = 0; i < 3; ++i) {
+        *p++ = ',';
+        p = put_int(p, gyro[i]);
+    }
+
+    // Temperatura em ponto fixo com duas casas decimais
+    int32_t centi = mpu6050_temp_centi_celsius(temp_raw);
+    *p++ = ',';
+    if (centi < 0) {
+        *p++ = '-';
+        centi = -centi;
+    }
+    p = put_int(p, centi / 100);
+    *p++ = '.';
+    p = put_fixed(p, (uint32_t)(centi % 100), 2);
+    *p++ = '\n';
+
+    return (size_t)(p - dst);
+}
+
+size_t csv_format_channels(char *dst, const datetime_t *dt, const csv_channel_t *channels, size_t n)
+{
+    char *p = put_timestamp(dst, dt);
+
+    for (size_t i = 0; i < n; ++i) {
+        *p++ = ',';
+        if (channels[i].valid)
+            p = put_decimal(p, channels[i].value, channels[i].decimals);
+    }
+    *p++ = '\n';
+
+    return (size_t)(p - dst);
+}
@@ -0,0 +1,35 @@
+#ifndef CSV_RECORD_H
+#define CSV_RECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Colunas de um registro genérico (csv_format_channels)
+#define CSV_MAX_CHANNELS 16
+
+// Tamanho máximo de um registro CSV: "YYYY-MM-DD,HH:MM:SS" + CSV_MAX_CHANNELS x
+// ",-2147483.648" + "\n" (cobre também o registro de csv_format_record)
+#define CSV_RECORD_MAX_LEN (20 + CSV_MAX_CHANNELS * 13)
+
+// Valor de uma coluna em ponto fixo: value / 10^decimals. Colunas inválidas
+// (sensor ainda sem amostra) saem vazias.
+typedef struct {
+    int32_t value;
+    uint8_t decimals;
+    bool valid;
+} csv_channel_t;
+
+// Escreve em dst (pelo menos CSV_RECORD_MAX_LEN bytes) o registro
+// "data,hora,ax,ay,az,gx,gy,gz,temp\n" sem usar printf nem ponto flutuante.
+// Com dt == NULL usa a data "0000-00-00,00:00:00". Retorna o comprimento.
+size_t csv_format_record(char *dst, const datetime_t *dt, const int16_t accel[3],
+                         const int16_t gyro[3], int16_t temp_raw);
+
+// Escreve em dst (pelo menos CSV_RECORD_MAX_LEN bytes) o registro
+// "data,hora,c0,c1,...\n" com n <= CSV_MAX_CHANNELS colunas, também sem printf
+// nem ponto flutuante. Retorna o comprimento.
+size_t csv_format_channels(char *dst, const datetime_t *dt, const csv_channel_t *channels, size_t n);
+
+#endif // CSV_RECORD_H
@@ -249,8 +249,21 @@ void run_cat()
         printf("f_open error: %s (%d)\n", FRESULT_str(fr), fr);
 }
 
-// Função para salvar dados do acelerômetro e giroscópio no cartão SD
-void save_data(const char *filename, int16_t aceleracao[3], int16_t gyro[3], float temp_celsius)
+// Buffer de registros do logger: os registros são formatados diretamente aqui e
+// gravados em blocos que terminam em fronteira de setor, de modo que o FatFs
+// transfere os setores completos direto deste buffer para o cartão.
+static char log_buffer[LOG_SECTOR_SIZE + CSV_RECORD_MAX_LEN];
+static size_t log_buffer_len = 0;
+static const char *data_header = "Date,Time,Acel_X,Acel_Y,Acel_Z,Gyro_X,Gyro_Y,Gyro_Z,Temp\n";
+
+void set_data_header(const char *header)
+{
+    data_header = header;
+}
+
+// Grava no arquivo os bytes pendentes do buffer. Com partial == false grava só
+// até a última fronteira de setor do arquivo e mantém o restante no buffer.
+static bool write_log_buffer(const char *filename, bool partial)
 {
     FIL file;
     FRESULT res;
@@ -261,57 +274,141 @@ void save_data(const char *filename, int16_t aceleracao[3], int16_t gyro[3], flo
     if (res != FR_OK)
     {
         printf("\n[ERRO] Não foi possível abrir o arquivo para escrita. Monte o Cartao.\n");
-        return;
+        return false;
     }
 
     // Se o arquivo é novo (tamanho = 0), escreve o cabeçalho
     if (f_size(&file) == 0) {
-        const char *header = "Date,Time,Acel_X,Acel_Y,Acel_Z,Gyro_X,Gyro_Y,Gyro_Z,Temp\n";
-        res = f_write(&file, header, strlen(header), &bw);
+        res = f_write(&file, data_header, strlen(data_header), &bw);
         if (res != FR_OK) {
             printf("[ERRO] Não foi possível escrever cabeçalho no arquivo.\n");
             f_close(&file);
-            return;
+            return false;
         }
     } else {
         // Se o arquivo já existe, posiciona o ponteiro no fim
         f_lseek(&file, f_size(&file));
     }
 
+    size_t len = log_buffer_len;
+    if (!partial)
+        len -= (f_size(&file) + log_buffer_len) % LOG_SECTOR_SIZE;
+
+    // Escreve no arquivo
+    TRACE_BEGIN(t_write);
+    res = f_write(&file, log_buffer, len, &bw);
+    TRACE_END(TRACE_F_WRITE, t_write);
+    f_close(&file);
+
+    if (res != FR_OK || bw != len) {
+        printf("[ERRO] Não foi possível escrever no arquivo. Monte o Cartao.\n");
+        return false;
+    }
+
+    // O que passou da fronteira de setor volta para o início do buffer
+    log_buffer_len -= len;
+    memmove(log_buffer, log_buffer + len, log_buffer_len);
+    return true;
+}
+
+// Início do próximo registro no buffer, ou NULL se não couber um registro
+// inteiro: depois de uma gravação que falhou (cartão cheio ou removido) os
+// bytes pendentes continuam no buffer e a gravação é tentada de novo aqui
+static char *reserve_record(const char *filename)
+{
+    if (sizeof(log_buffer) - log_buffer_len < CSV_RECORD_MAX_LEN &&
+        !write_log_buffer(filename, false))
+        return NULL;
+    if (sizeof(log_buffer) - log_buffer_len < CSV_RECORD_MAX_LEN)
+        return NULL;
+    return log_buffer + log_buffer_len;
+}
+
+// Envia o registro recém-formatado ao stream e grava os setores completos
+static void commit_record(const char *filename, const char *record, size_t len)
+{
+    log_buffer_len += len;
+
+    // Envia o registro ao stream ao vivo (USB), sem bloquear a captura
+    live_stream_push_record(record, len);
+
+    // Só acessa o cartão quando há pelo menos um setor completo pendente
+    if (log_buffer_len >= LOG_SECTOR_SIZE)
+        write_log_buffer(filename, false);
+}
+
+// Função para salvar dados do acelerômetro e giroscópio no cartão SD
+bool save_data(const char *filename, int16_t aceleracao[3], int16_t gyro[3], int16_t temp_raw)
+{
+    char *record = reserve_record(filename);
+    if (!record)
+        return false;
+
     // Obter data e hora atual para timestamp
+    TRACE_BEGIN(t_format);
     datetime_t dt;
-    char datetime_str[30];
+    bool has_rtc = rtc_get_datetime(&dt);
 
-    if (rtc_get_datetime(&dt)) {
-        sprintf(datetime_str, "%04d-%02d-%02d,%02d:%02d:%02d",
-                dt.year, dt.month, dt.day, dt.hour, dt.min, dt.sec);
-    } else {
-        strcpy(datetime_str, "0000-00-00,00:00:00");  // Fallback se o RTC não estiver disponível
-    }
+    // Formata o registro direto no buffer do logger
+    size_t len = csv_format_record(record, has_rtc ? &dt : NULL, aceleracao, gyro, temp_raw);
+    TRACE_END(TRACE_RECORD_FORMAT, t_format);
 
-    // Formata os dados para o arquivo CSV
-    char buffer[100];
-    sprintf(buffer, "%s,%d,%d,%d,%d,%d,%d,%.2f\n",
-            datetime_str,
-            aceleracao[0], aceleracao[1], aceleracao[2],
-            gyro[0], gyro[1], gyro[2], temp_celsius);
+    commit_record(filename, record, len);
+    return true;
+}
 
-    // Escreve no arquivo
-    res = f_write(&file, buffer, strlen(buffer), &bw);
-    if (res != FR_OK) {
-        printf("[ERRO] Não foi possível escrever no arquivo. Monte o Cartao.\n");
-        f_close(&file);
-        return;
+bool save_channels(const char *filename, const csv_channel_t *channels, size_t n)
+{
+    char *record = reserve_record(filename);
+    if (!record)
+        return false;
+
+    TRACE_BEGIN(t_format);
+    datetime_t dt;
+    bool has_rtc = rtc_get_datetime(&dt);
+
+    size_t len = csv_format_channels(record, has_rtc ? &dt : NULL, channels, n);
+    TRACE_END(TRACE_RECORD_FORMAT, t_format);
+
+    commit_record(filename, record, len);
+    return true;
+}
+
+bool save_metadata(const char *filename, const char *text)
+{
+    char *record = reserve_record(filename);
+    if (!record)
+        return false;
+
+    datetime_t dt;
+    bool has_rtc = rtc_get_datetime(&dt);
+
+    // Data e hora como num registro sem colunas; o texto entra no lugar do '\n'
+    record[0] = '#';
+    size_t len = csv_format_channels(record + 1, has_rtc ? &dt : NULL, NULL, 0);
+    int n = snprintf(record + len, CSV_RECORD_MAX_LEN - len, ",%s\n", text);
+    if (n < 0 || len + (size_t)n >= CSV_RECORD_MAX_LEN) {
+        len = CSV_RECORD_MAX_LEN - 1;  // Texto truncado, mas a linha termina
+        record[len - 1] = '\n';
+    } else {
+        len += (size_t)n;
     }
 
-    // Fecha o arquivo
-    f_close(&file);
+    commit_record(filename, record, len);
+    return true;
+}
 
-    // Exibe os dados no formato CSV para fácil cópia
-    printf("%s,%d,%d,%d,%d,%d,%d,%.2f\n",
-           datetime_str,
-           aceleracao[0], aceleracao[1], aceleracao[2],
-           gyro[0], gyro[1], gyro[2], temp_celsius);
+size_t pending_data_bytes()
+{
+    return log_buffer_len;
+}
+
+// Função para gravar no cartão SD os registros ainda no buffer
+bool flush_data(const char *filename)
+{
+    if (log_buffer_len == 0)
+        return true;
+    return write_log_buffer(filename, true);
 }
 
 // Função para ler o conteúdo de um arquivo e exibir no terminal de forma formatada
@@ -325,7 +422,7 @@ void read_file(const char *filename)
         return;
     }
 
-    char buffer[128];
+    char buffer[CSV_RECORD_MAX_LEN + 1];  // Uma linha inteira, mesmo com todos os canais
     int line_count = 0;
     bool header_processed = false;
 
@@ -16,6 +16,12 @@
 #include "my_debug.h"
 #include "rtc.h"
 #include "sd_card.h"
+#include "trace/trace.h"
+#include "csv_record.h"
+#include "live_stream/live_stream.h"
+
+// Registros são gravados no cartão em blocos de setores completos
+#define LOG_SECTOR_SIZE 512
 
 sd_card_t *sd_get_by_name(const char *const name);
 FATFS *sd_get_fs_by_name(const char *name);
@@ -27,8 +33,30 @@ void run_getfree();
 void run_ls();
 void run_cat();
 
-// Função para capturar dados do ADC e salvar no arquivo *.txt
-void save_data(const char *filename, int16_t aceleracao[3], int16_t gyro[3], float temp_celsius);
+// Função para formatar uma amostra e acumulá-la no buffer do logger; o arquivo
+// *.txt só é escrito quando há pelo menos um setor completo de registros.
+// Retorna false, descartando o registro, se o buffer estiver cheio porque a
+// gravação no cartão falhou (cartão cheio ou removido); os registros já no
+// buffer são mantidos e a gravação é tentada de novo no próximo registro.
+bool save_data(const char *filename, int16_t aceleracao[3], int16_t gyro[3], int16_t temp_raw);
+
+// Cabeçalho escrito em arquivos novos (padrão: colunas do MPU6050). O texto
+// não é copiado e deve continuar válido enquanto o logger estiver em uso.
+void set_data_header(const char *header);
+
+// Como save_data(), para um registro com as colunas dadas (ex.: as do
+// escalonador de sensores, na ordem do cabeçalho)
+bool save_channels(const char *filename, const csv_channel_t *channels, size_t n);
+
+// Registro de metadados "#data,hora,texto\n" intercalado com os dados (ex.:
+// contadores de falhas); leitores de CSV o ignoram como comentário
+bool save_metadata(const char *filename, const char *text);
+
+// Função para gravar no arquivo os registros pendentes no buffer
+bool flush_data(const char *filename);
+
+// Bytes de registros no buffer ainda não gravados no cartão
+size_t pending_data_bytes();
 
 // Função para ler o conteúdo de um arquivo e exibir no terminal
 void read_file(const char *filename);
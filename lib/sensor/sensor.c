@@ -0,0 +1,193 @@
+#include <stdio.h>
+#include <string.h>
+#include "sensor.h"
+#include "trace/trace.h"
+
+void sensor_sched_init(sensor_sched_t *sched)
+{
+    memset(sched, 0, sizeof(*sched));
+}
+
+bool sensor_sched_add(sensor_sched_t *sched, sensor_t *s, const sensor_driver_t *driver, void *ctx,
+                      uint32_t period_us)
+{
+    if (sched->count >= SENSOR_MAX_SENSORS || driver->num_channels > SENSOR_MAX_VALUES ||
+        sched->num_channels + driver->num_channels > CSV_MAX_CHANNELS)
+        return false;
+
+    memset(s, 0, sizeof(*s));
+    s->driver = driver;
+    s->ctx = ctx;
+    if (driver->init && !driver->init(s))
+        return false;
+
+    s->index = sched->count;
+    s->period_us = period_us ? period_us : driver->period_us;
+    s->next_due_us = time_us_64();
+    s->state = SENSOR_IDLE;
+
+    sched->sensors[sched->count++] = s;
+    sched->num_channels += driver->num_channels;
+    return true;
+}
+
+// Amostra perdida: o valor antigo não vai mais para os registros e, depois de
+// SENSOR_REINIT_ERRORS falhas seguidas, o sensor é reinicializado antes da
+// próxima amostra (um sensor que voltou após perder a alimentação responde,
+// mas perdeu a configuração)
+static void sensor_fail(sensor_t *s)
+{
+    s->stats.errors++;
+    s->valid = false;
+    if (++s->error_run >= SENSOR_REINIT_ERRORS && s->driver->init)
+        s->needs_init = true;
+}
+
+// Conclui a conversão em andamento se ela já terminou; retorna true com amostra nova
+static bool sensor_complete(sensor_t *s, uint64_t now_us)
+{
+    const sensor_driver_t *drv = s->driver;
+
+    if (now_us < s->ready_us)
+        return false;
+    if (drv->ready && !drv->ready(s)) {
+        if (s->ready_us <= now_us)
+            s->ready_us = now_us + SENSOR_READY_POLL_US;
+        // Conversão que não termina em um período inteiro é descartada
+        if (now_us - s->started_us >= drv->conversion_us + s->period_us) {
+            s->state = SENSOR_IDLE;
+            sensor_fail(s);
+        }
+        return false;
+    }
+
+    s->state = SENSOR_IDLE;
+    TRACE_BEGIN(t_read);
+    bool ok = drv->read(s, s->raw);
+    TRACE_END(TRACE_SENSOR_READ, t_read);
+    if (!ok) {
+        sensor_fail(s);
+        return false;
+    }
+
+    drv->decode(s, s->raw, s->values);
+    s->valid = true;
+    s->error_run = 0;
+    s->stats.samples++;
+    return true;
+}
+
+uint32_t sensor_sched_poll(sensor_sched_t *sched, uint64_t now_us)
+{
+    uint32_t fresh = 0;
+
+    for (uint8_t i = 0; i < sched->count; ++i) {
+        sensor_t *s = sched->sensors[i];
+
+        if (s->state == SENSOR_CONVERTING) {
+            if (sensor_complete(s, now_us))
+                fresh |= SENSOR_BIT(s);
+            continue;
+        }
+        if (now_us < s->next_due_us)
+            continue;
+
+        // Períodos perdidos não são recuperados em rajada: a linha do tempo
+        // segue a partir de agora
+        s->next_due_us += s->period_us;
+        if (s->next_due_us <= now_us) {
+            s->stats.late++;
+            s->next_due_us = now_us + s->period_us;
+        }
+
+        // Enquanto a reinicialização falhar, cada período conta como erro; os
+        // demais sensores seguem normalmente
+        if (s->needs_init) {
+            if (!s->driver->init(s)) {
+                sensor_fail(s);
+                continue;
+            }
+            s->needs_init = false;
+            s->error_run = 0;
+            s->stats.reinits++;
+        }
+
+        if (s->driver->start && !s->driver->start(s)) {
+            sensor_fail(s);
+            continue;
+        }
+        s->started_us = now_us;
+        s->ready_us = now_us + s->driver->conversion_us;
+        s->state = SENSOR_CONVERTING;
+
+        // Sensores de conversão contínua são lidos na mesma volta
+        if (sensor_complete(s, now_us))
+            fresh |= SENSOR_BIT(s);
+    }
+    return fresh;
+}
+
+uint64_t sensor_sched_next_us(const sensor_sched_t *sched)
+{
+    uint64_t next = UINT64_MAX;
+
+    for (uint8_t i = 0; i < sched->count; ++i) {
+        const sensor_t *s = sched->sensors[i];
+        uint64_t t = s->state == SENSOR_CONVERTING ? s->ready_us : s->next_due_us;
+        if (t < next)
+            next = t;
+    }
+    return next;
+}
+
+size_t sensor_sched_header(const sensor_sched_t *sched, char *dst, size_t size)
+{
+    int len = snprintf(dst, size, "Date,Time");
+
+    for (uint8_t i = 0; i < sched->count; ++i) {
+        const sensor_driver_t *drv = sched->sensors[i]->driver;
+        for (uint8_t c = 0; c < drv->num_channels && len >= 0 && (size_t)len < size; ++c)
+            len += snprintf(dst + len, size - len, ",%s", drv->channels[c].name);
+    }
+    if (len >= 0 && (size_t)len < size)
+        len += snprintf(dst + len, size - len, "\n");
+    return len < 0 ? 0 : ((size_t)len < size ? (size_t)len : size - 1);
+}
+
+size_t sensor_sched_channels(const sensor_sched_t *sched, csv_channel_t *out)
+{
+    size_t n = 0;
+
+    for (uint8_t i = 0; i < sched->count; ++i) {
+        const sensor_t *s = sched->sensors[i];
+        for (uint8_t c = 0; c < s->driver->num_channels; ++c, ++n) {
+            out[n].value = s->values[c];
+            out[n].decimals = s->driver->channels[c].decimals;
+            out[n].valid = s->valid;
+        }
+    }
+    return n;
+}
+
+void sensor_sched_print_stats(const sensor_sched_t *sched)
+{
+    for (uint8_t i = 0; i < sched->count; ++i) {
+        const sensor_t *s = sched->sensors[i];
+        printf("Sensor %s: periodo %lu ms, %lu amostras, %lu erros, %lu atrasos, %lu reinicios\n",
+               s->driver->name, (unsigned long)(s->period_us / 1000), (unsigned long)s->stats.samples,
+               (unsigned long)s->stats.errors, (unsigned long)s->stats.late,
+               (unsigned long)s->stats.reinits);
+    }
+}
+
+size_t sensor_sched_format_health(const sensor_sched_t *sched, char *dst, size_t size)
+{
+    int len = 0;
+
+    for (uint8_t i = 0; i < sched->count && len >= 0 && (size_t)len < size; ++i) {
+        const sensor_t *s = sched->sensors[i];
+        len += snprintf(dst + len, size - len, "%s%s %lu erros %lu reinicios", i ? "," : "",
+                        s->driver->name, (unsigned long)s->stats.errors, (unsigned long)s->stats.reinits);
+    }
+    return len < 0 ? 0 : ((size_t)len < size ? (size_t)len : size - 1);
+}
@@ -0,0 +1,111 @@
+#ifndef SENSOR_H
+#define SENSOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+#include "sd_card/csv_record.h"
+
+// Interface comum dos sensores e escalonador multi-sensor. Cada driver expõe
+// um sensor_driver_t com as etapas de uma amostra (disparar a conversão,
+// verificar se terminou, transferir os bytes crus e decodificá-los em valores
+// de ponto fixo); o escalonador intercala os sensores numa linha do tempo
+// única, cada um no seu período, sem nunca esperar por uma conversão lenta.
+
+#define SENSOR_MAX_SENSORS 4
+#define SENSOR_MAX_VALUES 8    // Canais de um sensor
+#define SENSOR_RAW_MAX 16      // Bytes crus de uma amostra
+#define SENSOR_READY_POLL_US 1000  // Intervalo entre consultas a ready() que retornaram false
+#define SENSOR_REINIT_ERRORS 3     // Falhas seguidas antes de reinicializar o sensor (init())
+
+typedef struct sensor sensor_t;
+
+// Coluna do registro: valor = value / 10^decimals
+typedef struct {
+    const char *name;
+    uint8_t decimals;
+} sensor_channel_t;
+
+typedef struct {
+    const char *name;
+    const sensor_channel_t *channels;
+    uint8_t num_channels;
+    uint32_t period_us;        // Período padrão de amostragem
+    uint32_t conversion_us;    // Tempo mínimo entre start() e read()
+
+    bool (*init)(sensor_t *s);                          // false: sensor ausente; também
+                                                        // usada para reinicializá-lo
+    bool (*start)(sensor_t *s);                         // NULL: conversão contínua
+    bool (*ready)(sensor_t *s);                         // NULL: pronto após conversion_us;
+                                                        // pode adiar a próxima consulta (ready_us)
+    bool (*read)(sensor_t *s, uint8_t *raw);            // Transfere a amostra crua
+    void (*decode)(sensor_t *s, const uint8_t *raw, int32_t *values);
+} sensor_driver_t;
+
+typedef enum {
+    SENSOR_IDLE,
+    SENSOR_CONVERTING
+} sensor_state_t;
+
+typedef struct {
+    uint32_t samples;
+    uint32_t errors;           // Falhas de start()/read() e conversões que não terminaram
+    uint32_t late;             // Períodos perdidos por atraso do laço principal
+    uint32_t reinits;          // Reinicializações bem-sucedidas após falhas seguidas
+} sensor_stats_t;
+
+struct sensor {
+    const sensor_driver_t *driver;
+    void *ctx;                 // Estado do driver, se houver
+    uint8_t index;             // Posição no escalonador (bit em sensor_sched_poll())
+    uint32_t period_us;
+    uint64_t next_due_us;
+    uint64_t started_us;
+    uint64_t ready_us;         // Próxima consulta a ready() da conversão em andamento
+    sensor_state_t state;
+    bool valid;                // values contém uma amostra (false após uma falha)
+    uint8_t error_run;         // Falhas seguidas desde a última amostra
+    bool needs_init;           // init() antes da próxima amostra
+    uint8_t raw[SENSOR_RAW_MAX];
+    int32_t values[SENSOR_MAX_VALUES];
+    sensor_stats_t stats;
+};
+
+#define SENSOR_BIT(s) (1u << (s)->index)
+
+typedef struct {
+    sensor_t *sensors[SENSOR_MAX_SENSORS];
+    uint8_t count;
+    uint8_t num_channels;
+} sensor_sched_t;
+
+void sensor_sched_init(sensor_sched_t *sched);
+
+// Inicializa o sensor e o registra com o período dado (0 = padrão do driver).
+// Retorna false, sem registrar, se o sensor não responder ou não houver espaço.
+bool sensor_sched_add(sensor_sched_t *sched, sensor_t *s, const sensor_driver_t *driver, void *ctx,
+                      uint32_t period_us);
+
+// Avança a linha do tempo até now_us: conclui as conversões prontas e dispara
+// as que venceram. Retorna a máscara (SENSOR_BIT) dos sensores com amostra nova.
+uint32_t sensor_sched_poll(sensor_sched_t *sched, uint64_t now_us);
+
+// Instante do próximo evento (conversão a concluir ou amostra a disparar)
+uint64_t sensor_sched_next_us(const sensor_sched_t *sched);
+
+// Cabeçalho CSV "Date,Time,<canais>\n" gerado a partir dos sensores registrados
+size_t sensor_sched_header(const sensor_sched_t *sched, char *dst, size_t size);
+
+// Últimos valores de todos os canais, na ordem do cabeçalho; canais de sensores
+// ainda sem amostra saem inválidos. out deve ter CSV_MAX_CHANNELS posições.
+size_t sensor_sched_channels(const sensor_sched_t *sched, csv_channel_t *out);
+
+// Imprime amostras, erros e atrasos de cada sensor no stdio
+void sensor_sched_print_stats(const sensor_sched_t *sched);
+
+// Erros e reinicializações de cada sensor, em texto ("MPU6050 0 erros
+// 0 reinicios,BMP280 ..."), para os registros de metadados
+size_t sensor_sched_format_health(const sensor_sched_t *sched, char *dst, size_t size);
+
+#endif // SENSOR_H
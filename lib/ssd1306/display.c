@@ -1,28 +1,55 @@
 #include "display.h"
 
+// Memória do display reservada estaticamente (sem heap)
+SSD1306_FRAMEBUFFER(display_fb, WIDTH, HEIGHT);
+
 void init_display(ssd1306_t *ssd)
 {
-    // I2C Initialisation. Using it at 400Khz.
-    i2c_init(SSD1306_I2C_PORT, 400 * 1000);
-
-    gpio_set_function(SSD1306_I2C_SDA, GPIO_FUNC_I2C);                          // Set the GPIO pin function to I2C
-    gpio_set_function(SSD1306_I2C_SCL, GPIO_FUNC_I2C);                          // Set the GPIO pin function to I2C
-    gpio_pull_up(SSD1306_I2C_SDA);                                              // Pull up the data line
-    gpio_pull_up(SSD1306_I2C_SCL);                                              // Pull up the clock line
+    i2c_inst_t *i2c = i2c_dev_init(I2C_DEV_SSD1306);                           // Pinos e velocidade vêm da tabela I2C
                                                                                 // Inicializa a estrutura do display
-    ssd1306_init(ssd, WIDTH, HEIGHT, false, SSD1306_ADDRESS, SSD1306_I2C_PORT); // Inicializa o display
+    ssd1306_init(ssd, WIDTH, HEIGHT, false, SSD1306_ADDRESS, i2c, &display_fb);
     ssd1306_config(ssd);                                                        // Configura o display
-    ssd1306_send_data(ssd);
+    ssd1306_send_data(ssd);                                                     // Envia o framebuffer limpo
+    ssd1306_enable_dma(ssd);                                                    // Próximos quadros por DMA
+}
 
-    ssd1306_init(ssd, WIDTH, HEIGHT, false, SSD1306_ADDRESS, SSD1306_I2C_PORT); // Inicializa o display
-    ssd1306_config(ssd);                                                        // Configura o display
-    ssd1306_send_data(ssd);                                                     // Envia os dados para o display
-    ssd1306_fill(ssd, false);                                                   // Limpa o display
-    ssd1306_send_data(ssd);
+void display_sched_init(display_sched_t *sched, uint32_t max_fps)
+{
+    memset(sched, 0, sizeof(*sched));
+    sched->min_interval_us = max_fps ? 1000000u / max_fps : 0;
+}
+
+void display_sched_request(display_sched_t *sched)
+{
+    sched->pending = true;
+    sched->requests++;
+}
+
+bool display_sched_due(display_sched_t *sched, ssd1306_t *ssd, bool storage_busy)
+{
+    if (!sched->pending)
+        return false;
+
+    uint64_t now = time_us_64();
+    if (sched->refreshes && now - sched->last_refresh_us < sched->min_interval_us)
+        return false;
+
+    if (storage_busy || ssd1306_busy(ssd)) {
+        if (!sched->held)           // Conta uma vez por quadro, não por volta do laço
+            sched->deferred++;
+        sched->held = true;
+        return false;
+    }
+
+    sched->pending = false;
+    sched->held = false;
+    sched->last_refresh_us = now;
+    sched->refreshes++;
+    return true;
 }
 
 void draw_centered_text(ssd1306_t *ssd, const char *text, int y)
 {
-    int x = (128 - (strlen(text) * 8)) / 2; // Calcula a posição X para centralizar
+    int x = (ssd->width - font_text_width(&font_8x8, text)) / 2; // Calcula a posição X para centralizar
     ssd1306_draw_string(ssd, text, x, y);   // Desenha o texto na posição calculada
 }
\ No newline at end of file
@@ -6,12 +6,39 @@
 #include "ssd1306.h"
 #include "string.h"
 
-#define SSD1306_I2C_PORT i2c1
-#define SSD1306_I2C_SDA 14
-#define SSD1306_I2C_SCL 15
+#include "i2c_bus/i2c_bus.h"
+
+// Barramento do display (pinos e velocidade em config/i2c_config.c)
+#define SSD1306_I2C_PORT i2c_dev_port(I2C_DEV_SSD1306)
 #define SSD1306_ADDRESS 0x3C
 
+#define DISPLAY_MAX_FPS 4   // Limite padrão de atualizações por segundo
+
+// Agendador de atualizações do display: pedidos entre dois quadros são
+// agrupados em um só, o intervalo mínimo entre quadros vem do limite de FPS e
+// o quadro é adiado quando o armazenamento está perto de gravar ou o quadro
+// anterior ainda está no barramento.
+typedef struct {
+    uint32_t min_interval_us;
+    uint64_t last_refresh_us;
+    bool pending;
+    bool held;            // Quadro pendente já contado em deferred
+    uint32_t requests;    // Pedidos de atualização
+    uint32_t refreshes;   // Quadros efetivamente desenhados
+    uint32_t deferred;    // Quadros que cederam a vez ao armazenamento ou ao barramento
+} display_sched_t;
+
 void init_display(ssd1306_t *ssd);
 void draw_centered_text(ssd1306_t *ssd, const char *text, int y);
 
+// max_fps == 0 remove o limite de taxa
+void display_sched_init(display_sched_t *sched, uint32_t max_fps);
+
+// Registra que o estado exibido mudou
+void display_sched_request(display_sched_t *sched);
+
+// Verdadeiro quando o quadro pendente deve ser desenhado agora; storage_busy
+// indica que a gravação no cartão tem prioridade nesta volta do laço
+bool display_sched_due(display_sched_t *sched, ssd1306_t *ssd, bool storage_busy);
+
 #endif // SSD1306_DISPLAY_H
@@ -0,0 +1,22 @@
+# Tabelas de fonte do SSD1306 geradas no build a partir das fontes BDF.
+# Define SSD1306_FONT_SOURCE com o .c gerado, a ser incluído no alvo.
+
+find_package(Python3 REQUIRED COMPONENTS Interpreter)
+
+set(SSD1306_FONT_BDF ${CMAKE_CURRENT_LIST_DIR}/font8x8.bdf)
+set(SSD1306_FONT_GENERATOR ${CMAKE_CURRENT_LIST_DIR}/../../../tools/fontgen.py)
+set(SSD1306_FONT_SOURCE ${CMAKE_CURRENT_BINARY_DIR}/generated/ssd1306_fonts.c)
+
+add_custom_command(
+        OUTPUT ${SSD1306_FONT_SOURCE}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/generated
+        COMMAND ${Python3_EXECUTABLE} ${SSD1306_FONT_GENERATOR}
+                --output ${SSD1306_FONT_SOURCE}
+                --font "font_8x8:${SSD1306_FONT_BDF}:mono:1: -~"
+                --font "font_prop:${SSD1306_FONT_BDF}:prop:1: -~"
+                --font "font_digits_2x:${SSD1306_FONT_BDF}:mono:2:0-9"
+                --font "font_digits_3x:${SSD1306_FONT_BDF}:mono:3:0-9"
+        DEPENDS ${SSD1306_FONT_GENERATOR} ${SSD1306_FONT_BDF}
+        COMMENT "Gerando tabelas de fonte do SSD1306"
+        VERBATIM
+)
@@ -1,49 +1,93 @@
+#include <string.h>
 #include "ssd1306.h"
-#include "font.h"
+#include "trace/trace.h"
+#include "i2c_bus/i2c_bus.h"
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c) {
+// Sem alocação dinâmica: toda a memória vem de fb (ver SSD1306_FRAMEBUFFER),
+// então chamar de novo com o mesmo fb apenas reinicia o estado
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c,
+                  const ssd1306_framebuffer_t *fb) {
   ssd->width = width;
   ssd->height = height;
   ssd->pages = height / 8U;
   ssd->address = address;
   ssd->i2c_port = i2c;
-  ssd->bufsize = ssd->pages * ssd->width + 1;
-  ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
+  ssd->external_vcc = external_vcc;
+  ssd->bufsize = SSD1306_BUFSIZE(width, height);
+  ssd->ram_buffer = fb->ram_buffer;
+  ssd->shadow_buffer = fb->shadow_buffer;
+  memset(ssd->ram_buffer, 0, ssd->bufsize);
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->dma_chan = -1;
+  ssd->tx_stream = fb->tx_stream;
+  ssd->tx_len = 0;
+  ssd->flush_pending = false;
+  ssd1306_mark_all_dirty(ssd);
+}
+
+// Passa a enviar os quadros por DMA; sem canal livre (ou sem tx_stream no
+// framebuffer) continua bloqueante
+bool ssd1306_enable_dma(ssd1306_t *ssd) {
+  if (ssd->dma_chan >= 0)
+    return true;
+
+  if (!ssd->tx_stream)
+    return false;
+
+  int chan = dma_claim_unused_channel(false);
+  if (chan < 0)
+    return false;
+  ssd->dma_chan = chan;
+  return true;
+}
+
+// Verdadeiro enquanto um quadro ainda está sendo enviado
+bool ssd1306_busy(ssd1306_t *ssd) {
+  if (ssd->dma_chan < 0)
+    return false;
+  if (dma_channel_is_busy(ssd->dma_chan))
+    return true;
+  // O DMA termina ao encher o FIFO; os últimos bytes ainda estão no barramento
+  uint32_t status = i2c_get_hw(ssd->i2c_port)->status;
+  return !(status & I2C_IC_STATUS_TFE_BITS) || (status & I2C_IC_STATUS_ACTIVITY_BITS);
+}
+
+// Envia o quadro adiado por ssd1306_send_data() quando o anterior terminar
+void ssd1306_poll(ssd1306_t *ssd) {
+  if (ssd->flush_pending && !ssd1306_busy(ssd))
+    ssd1306_send_data(ssd);
 }
 
 void ssd1306_config(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  const uint8_t init[] = {
+    SET_DISP | 0x00,
+    SET_MEM_ADDR, 0x01,
+    SET_DISP_START_LINE | 0x00,
+    SET_SEG_REMAP | 0x01,
+    SET_MUX_RATIO, ssd->height - 1,
+    SET_COM_OUT_DIR | 0x08,
+    SET_DISP_OFFSET, 0x00,
+    SET_COM_PIN_CFG, ssd->height == 32 ? 0x02 : 0x12,
+    SET_DISP_CLK_DIV, 0x80,
+    SET_PRECHARGE, 0xF1,
+    SET_VCOM_DESEL, 0x30,
+    SET_CONTRAST, 0xFF,
+    SET_ENTIRE_ON,
+    SET_NORM_INV,
+    SET_CHARGE_PUMP, 0x14,
+    SET_DISP | 0x01
+  };
+  ssd1306_commands(ssd, init, sizeof(init));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
+  // Comandos avulsos não podem se intercalar com um quadro em envio
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  i2c_bus_write(
     ssd->i2c_port,
     ssd->address,
     ssd->port_buffer,
@@ -52,69 +96,298 @@ void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   );
 }
 
-void ssd1306_send_data(ssd1306_t *ssd) {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-    ssd->i2c_port,
-    ssd->address,
-    ssd->ram_buffer,
-    ssd->bufsize,
-    false
-  );
+// Envia uma sequência de comandos (com seus argumentos) numa só transação: o
+// byte de controle 0x00 (Co = 0) vale para todos os bytes que o seguem
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t len) {
+  uint8_t buffer[1 + SSD1306_MAX_COMMAND_BATCH];
+
+  while (ssd1306_busy(ssd))
+    tight_loop_contents();
+
+  buffer[0] = 0x00;
+  while (len > 0) {
+    size_t n = len > SSD1306_MAX_COMMAND_BATCH ? SSD1306_MAX_COMMAND_BATCH : len;
+    memcpy(buffer + 1, commands, n);
+    i2c_bus_write(ssd->i2c_port, ssd->address, buffer, n + 1, false);
+    commands += n;
+    len -= n;
+  }
 }
 
-void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
-  uint16_t index = (y >> 3) + (x << 3) + 1;
-  uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+static inline void ssd1306_mark_page(ssd1306_t *ssd, uint8_t page, uint8_t x0, uint8_t x1) {
+  if (x0 < ssd->dirty_x0[page])
+    ssd->dirty_x0[page] = x0;
+  if (x1 > ssd->dirty_x1[page])
+    ssd->dirty_x1[page] = x1;
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+  if (x0 > x1 || y0 > y1)
+    return;
+  for (uint8_t page = y0 >> 3; page <= (y1 >> 3); ++page)
+    ssd1306_mark_page(ssd, page, x0, x1);
+}
 
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-    // Itera por todas as posições do display
-    for (uint8_t y = 0; y < ssd->height; ++y) {
-        for (uint8_t x = 0; x < ssd->width; ++x) {
-            ssd1306_pixel(ssd, x, y, value);
-        }
+// Força o reenvio da tela inteira (conteúdo da GDDRAM desconhecido)
+void ssd1306_mark_all_dirty(ssd1306_t *ssd) {
+  ssd->shadow_valid = false;
+  for (uint8_t page = 0; page < SSD1306_MAX_PAGES; ++page) {
+    ssd->dirty_x0[page] = 0;
+    ssd->dirty_x1[page] = ssd->width - 1;
+  }
+}
+
+static inline void ssd1306_clear_dirty(ssd1306_t *ssd) {
+  for (uint8_t page = 0; page < SSD1306_MAX_PAGES; ++page) {
+    ssd->dirty_x0[page] = 0xFF;
+    ssd->dirty_x1[page] = 0;
+  }
+}
+
+// Acrescenta a janela ao fluxo do DMA: uma transação com os comandos de
+// endereçamento (controle 0x00) e outra com os dados (controle 0x40). O STOP
+// fica no bit 9 da palavra de IC_DATA_CMD.
+static void ssd1306_queue_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  uint16_t *out = ssd->tx_stream + ssd->tx_len;
+
+  *out++ = 0x00;
+  *out++ = SET_COL_ADDR;
+  *out++ = x0;
+  *out++ = x1;
+  *out++ = SET_PAGE_ADDR;
+  *out++ = p0;
+  *out++ = p1 | I2C_IC_DATA_CMD_STOP_BITS;
+
+  *out++ = 0x40;
+  for (uint16_t x = x0; x <= x1; ++x) {
+    for (uint8_t p = p0; p <= p1; ++p)
+      *out++ = ssd->ram_buffer[x * ssd->pages + p + 1];
+  }
+  out[-1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+  ssd->tx_len = out - ssd->tx_stream;
+}
+
+static void ssd1306_start_dma(ssd1306_t *ssd) {
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_chan);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(ssd->i2c_port, true));
+  dma_channel_configure(ssd->dma_chan, &c, &hw->data_cmd, ssd->tx_stream, ssd->tx_len, true);
+}
+
+// Envia a janela [x0..x1] x [p0..p1]. O display está em endereçamento vertical,
+// então os dados seguem coluna a coluna; com todas as páginas a janela é um
+// trecho contíguo de ram_buffer e vai direto, senão é copiada em blocos (o
+// ponteiro de GDDRAM do SSD1306 continua entre transações).
+static void ssd1306_send_window(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t p0, uint8_t p1) {
+  if (ssd->dma_chan >= 0) {
+    ssd1306_queue_window(ssd, x0, x1, p0, p1);
+    return;
+  }
+
+  const uint8_t window[] = {SET_COL_ADDR, x0, x1, SET_PAGE_ADDR, p0, p1};
+  ssd1306_commands(ssd, window, sizeof(window));
+
+  if (p0 == 0 && p1 == ssd->pages - 1) {
+    // O byte anterior à janela recebe temporariamente o byte de controle 0x40
+    uint8_t *start = &ssd->ram_buffer[(size_t)x0 * ssd->pages];
+    uint8_t saved = *start;
+    *start = 0x40;
+    i2c_bus_write(ssd->i2c_port, ssd->address, start,
+                       (size_t)(x1 - x0 + 1) * ssd->pages + 1, false);
+    *start = saved;
+    return;
+  }
+
+  uint8_t chunk[1 + 128];
+  size_t len = 1;
+  chunk[0] = 0x40;
+  for (uint16_t x = x0; x <= x1; ++x) {
+    for (uint8_t p = p0; p <= p1; ++p) {
+      chunk[len++] = ssd->ram_buffer[x * ssd->pages + p + 1];
+      if (len == sizeof(chunk)) {
+        i2c_bus_write(ssd->i2c_port, ssd->address, chunk, len, false);
+        len = 1;
+      }
     }
+  }
+  if (len > 1)
+    i2c_bus_write(ssd->i2c_port, ssd->address, chunk, len, false);
 }
 
+// Reduz a faixa suja de uma página às colunas que diferem do display
+static void ssd1306_trim_page(ssd1306_t *ssd, uint8_t page) {
+  uint8_t x0 = ssd->dirty_x0[page], x1 = ssd->dirty_x1[page];
+  const uint8_t *ram = ssd->ram_buffer + page + 1;
+  const uint8_t *shadow = ssd->shadow_buffer + page + 1;
 
+  while (x0 <= x1 && ram[x0 * ssd->pages] == shadow[x0 * ssd->pages])
+    ++x0;
+  while (x1 > x0 && ram[x1 * ssd->pages] == shadow[x1 * ssd->pages])
+    --x1;
 
-void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
-  for (uint8_t x = left; x < left + width; ++x) {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
+  if (x0 > x1) {
+    ssd->dirty_x0[page] = 0xFF;
+    ssd->dirty_x1[page] = 0;
+  } else {
+    ssd->dirty_x0[page] = x0;
+    ssd->dirty_x1[page] = x1;
   }
-  for (uint8_t y = top; y < top + height; ++y) {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
+}
+
+void ssd1306_send_data(ssd1306_t *ssd) {
+  TRACE_BEGIN(t_send);
+
+  if (ssd->dma_chan >= 0) {
+    // Quadro anterior ainda no barramento: as regiões continuam sujas e o
+    // envio fica para ssd1306_poll()
+    if (ssd1306_busy(ssd)) {
+      ssd->flush_pending = true;
+      TRACE_END(TRACE_SSD1306_SEND, t_send);
+      return;
+    }
+    // NACK no quadro anterior: o conteúdo do display é desconhecido e o
+    // quadro vai de novo, em 400 kHz se o barramento estava acima disso
+    i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+    if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+      (void)hw->clr_tx_abrt;
+      i2c_bus_fall_back(ssd->i2c_port);
+      ssd1306_mark_all_dirty(ssd);
+    }
+    ssd->flush_pending = false;
+    ssd->tx_len = 0;
   }
 
-  if (fill) {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x) {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y) {
-        ssd1306_pixel(ssd, x, y, value);
+  if (ssd->shadow_valid) {
+    for (uint8_t page = 0; page < ssd->pages; ++page) {
+      if (ssd->dirty_x0[page] <= ssd->dirty_x1[page])
+        ssd1306_trim_page(ssd, page);
+    }
+  }
+
+  // Janela envolvente de todas as páginas sujas e custo de uma janela por página
+  uint8_t p0 = 0xFF, p1 = 0, x0 = 0xFF, x1 = 0;
+  uint32_t per_page_cost = 0;
+  for (uint8_t page = 0; page < ssd->pages; ++page) {
+    if (ssd->dirty_x0[page] > ssd->dirty_x1[page])
+      continue;
+    if (p0 == 0xFF)
+      p0 = page;
+    p1 = page;
+    if (ssd->dirty_x0[page] < x0)
+      x0 = ssd->dirty_x0[page];
+    if (ssd->dirty_x1[page] > x1)
+      x1 = ssd->dirty_x1[page];
+    per_page_cost += SSD1306_WINDOW_OVERHEAD + ssd->dirty_x1[page] - ssd->dirty_x0[page] + 1;
+  }
+
+  if (p0 != 0xFF) {
+    uint32_t bbox_cost = SSD1306_WINDOW_OVERHEAD + (uint32_t)(x1 - x0 + 1) * (p1 - p0 + 1);
+    if (bbox_cost <= per_page_cost) {
+      ssd1306_send_window(ssd, x0, x1, p0, p1);
+    } else {
+      for (uint8_t page = p0; page <= p1; ++page) {
+        if (ssd->dirty_x0[page] <= ssd->dirty_x1[page])
+          ssd1306_send_window(ssd, ssd->dirty_x0[page], ssd->dirty_x1[page], page, page);
       }
     }
+    // Fora das faixas sujas o shadow já é igual a ram_buffer
+    for (uint8_t page = p0; page <= p1; ++page) {
+      for (uint16_t x = ssd->dirty_x0[page]; x <= ssd->dirty_x1[page] && x < ssd->width; ++x)
+        ssd->shadow_buffer[x * ssd->pages + page + 1] = ssd->ram_buffer[x * ssd->pages + page + 1];
+    }
+    ssd->shadow_valid = true;
+    ssd1306_clear_dirty(ssd);
+
+    if (ssd->dma_chan >= 0)
+      ssd1306_start_dma(ssd);
+  }
+
+  TRACE_END(TRACE_SSD1306_SEND, t_send);
+}
+
+// Substitui os bits de mask no byte (x, page); só marca a região como suja
+// quando o byte realmente muda
+static inline void ssd1306_write_bits(ssd1306_t *ssd, uint8_t x, uint8_t page, uint8_t mask, uint8_t bits) {
+  uint8_t *byte = &ssd->ram_buffer[x * ssd->pages + page + 1];
+  uint8_t updated = (*byte & ~mask) | (bits & mask);
+  if (updated != *byte) {
+    *byte = updated;
+    ssd1306_mark_page(ssd, page, x, x);
+  }
+}
+
+// Preenche a coluna x de y0 a y1 (inclusive), um byte de página por vez
+static void ssd1306_vspan(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
+  if (x >= ssd->width || y0 > y1 || y0 >= ssd->height)
+    return;
+  if (y1 >= ssd->height)
+    y1 = ssd->height - 1;
+
+  uint8_t bits = value ? 0xFF : 0x00;
+  for (uint8_t page = y0 >> 3; page <= (y1 >> 3); ++page) {
+    uint8_t mask = 0xFF;
+    if (page == (y0 >> 3))
+      mask &= 0xFF << (y0 & 7);
+    if (page == (y1 >> 3))
+      mask &= 0xFF >> (7 - (y1 & 7));
+    ssd1306_write_bits(ssd, x, page, mask, bits);
+  }
+}
+
+void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value) {
+  uint8_t mask = 1 << (y & 0b111);
+  ssd1306_write_bits(ssd, x, y >> 3, mask, value ? mask : 0);
+}
+
+// Preenche o framebuffer inteiro com memset; o flush compara com o shadow e
+// envia só o que de fato mudou
+void ssd1306_fill(ssd1306_t *ssd, bool value) {
+  memset(ssd->ram_buffer + 1, value ? 0xFF : 0x00, ssd->bufsize - 1);
+  ssd1306_mark_dirty(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
+}
+
+void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill) {
+  if (width == 0 || height == 0)
+    return;
+
+  uint8_t right = left + width - 1;
+  uint8_t bottom = top + height - 1;
+
+  if (fill) {
+    for (uint16_t x = left; x <= right && x < ssd->width; ++x)
+      ssd1306_vspan(ssd, x, top, bottom, value);
+    return;
   }
+
+  ssd1306_hline(ssd, left, right, top, value);
+  ssd1306_hline(ssd, left, right, bottom, value);
+  ssd1306_vspan(ssd, left, top, bottom, value);
+  ssd1306_vspan(ssd, right, top, bottom, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value) {
+    // Linhas horizontais e verticais usam os caminhos por byte
+    if (y0 == y1) {
+        ssd1306_hline(ssd, x0 < x1 ? x0 : x1, x0 < x1 ? x1 : x0, y0, value);
+        return;
+    }
+    if (x0 == x1) {
+        ssd1306_vspan(ssd, x0, y0 < y1 ? y0 : y1, y0 < y1 ? y1 : y0, value);
+        return;
+    }
+
     int dx = abs(x1 - x0);
     int dy = abs(y1 - y0);
 
@@ -144,40 +417,84 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value) {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y >= ssd->height)
+    return;
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+
+  // A mesma máscara de bit em bytes consecutivos da página (passo de 8 no buffer)
+  uint8_t mask = 1 << (y & 0b111);
+  uint8_t bits = value ? mask : 0;
+  for (uint16_t x = x0; x <= x1; ++x)
+    ssd1306_write_bits(ssd, x, y >> 3, mask, bits);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value) {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  ssd1306_vspan(ssd, x, y0, y1, value);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
-{
-  uint16_t index = 0;
+// Desloca n colunas para a esquerda a janela [x0..x1] x [page0..page1] e
+// apaga as colunas liberadas à direita; as demais páginas não são tocadas
+void ssd1306_scroll_left(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1, uint8_t n) {
+  if (x1 >= ssd->width)
+    x1 = ssd->width - 1;
+  if (page1 >= ssd->pages)
+    page1 = ssd->pages - 1;
+  if (x0 > x1 || page0 > page1 || n == 0)
+    return;
 
-  // Verifica o caractere e calcula o índice correspondente na fonte
-  if (c >= ' ' && c <= '~') // Verifica se o caractere está na faixa ASCII válida
-  {
-    index = (c - ' ') * 8; // Calcula o índice baseado na posição do caractere na tabela ASCII
-  }
-  else
-  {
-    // Caractere inválido, desenha um espaço (ou pode ser tratado de outra forma)
-    index = 0; // Índice 0 corresponde ao caractere "nada" (espaço)
+  uint8_t span = page1 - page0 + 1;
+  for (uint16_t x = x0; x <= x1; ++x) {
+    uint8_t *dst = &ssd->ram_buffer[x * ssd->pages + page0 + 1];
+    if (x + n <= x1)
+      memcpy(dst, dst + (uint16_t)n * ssd->pages, span);
+    else
+      memset(dst, 0, span);
   }
+  for (uint8_t page = page0; page <= page1; ++page)
+    ssd1306_mark_page(ssd, page, x0, x1);
+}
 
-  // Desenha o caractere na tela
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i]; // Acessa a linha correspondente do caractere na fonte
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j)); // Desenha cada pixel do caractere
+// Copia um glifo (colunas de bytes de página) para (x, y). Com y alinhado cada
+// byte vai direto para uma página; senão se divide entre duas. Os glifos são
+// opacos e caracteres fora da fonte desenham um espaço. Retorna o avanço.
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const font_t *font, char c, uint8_t x, uint8_t y) {
+  uint8_t code = (uint8_t)c;
+  bool present = code >= font->first && code <= font->last;
+  uint8_t width = present ? font->width[code - font->first] : font->missing_width;
+  const uint8_t *column = present ? font->data + font->offset[code - font->first] : NULL;
+
+  uint8_t page = y >> 3;
+  uint8_t shift = y & 0b111;
+  for (uint8_t i = 0; i < width; ++i) {
+    uint16_t col = x + i;
+    if (col >= ssd->width)
+      break;
+
+    for (uint8_t p = 0; p < font->pages; ++p) {
+      uint8_t bits = column ? column[i * font->pages + p] : 0;
+      uint8_t dst = page + p;
+      if (dst < ssd->pages)
+        ssd1306_write_bits(ssd, col, dst, 0xFF << shift, bits << shift);
+      if (shift && dst + 1 < ssd->pages)
+        ssd1306_write_bits(ssd, col, dst + 1, 0xFF >> (8 - shift), bits >> (8 - shift));
     }
   }
+  return width;
+}
+
+// Desenha o texto em uma linha com a fonte indicada; retorna o x final
+uint16_t ssd1306_draw_text(ssd1306_t *ssd, const font_t *font, const char *str, uint8_t x, uint8_t y) {
+  uint16_t pos = x;
+  while (*str && pos < ssd->width)
+    pos += ssd1306_draw_glyph(ssd, font, *str++, (uint8_t)pos, y);
+  return pos;
+}
+
+// Função para desenhar um caractere
+void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  ssd1306_draw_glyph(ssd, &font_8x8, c, x, y);
 }
 
 // Função para desenhar uma string
@@ -4,9 +4,29 @@
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
+#include "font.h"
 
 #define WIDTH 128
 #define HEIGHT 64
+#define SSD1306_MAX_PAGES 8
+
+// Custo aproximado, em bytes de I2C, de abrir uma janela de envio: transação
+// de endereçamento (endereço + 0x00 + 6 bytes de comando) e cabeçalho da
+// transação de dados (endereço + 0x40); usado para decidir entre uma janela
+// por página suja ou uma única janela envolvente
+#define SSD1306_WINDOW_OVERHEAD 10
+
+// Maior lote de comandos por transação em ssd1306_commands(); lotes maiores
+// são divididos (o SSD1306 não limita o tamanho, é só o buffer na pilha)
+#define SSD1306_MAX_COMMAND_BATCH 32
+
+// Bytes do framebuffer de um display w x h: byte de controle 0x40 + GDDRAM
+#define SSD1306_BUFSIZE(w, h) ((w) * ((h) / 8) + 1)
+
+// Palavras de IC_DATA_CMD para o pior quadro enviado por DMA: o framebuffer
+// inteiro mais comandos e byte de controle de uma janela por página
+#define SSD1306_TX_STREAM_WORDS(w, h) ((w) * ((h) / 8) + ((h) / 8) * 9)
 
 typedef enum {
   SET_CONTRAST = 0x81,
@@ -28,6 +48,21 @@ typedef enum {
   SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Memória de um display, fornecida por quem chama ssd1306_init()
+typedef struct {
+  uint8_t *ram_buffer;     // SSD1306_BUFSIZE(w, h) bytes
+  uint8_t *shadow_buffer;  // SSD1306_BUFSIZE(w, h) bytes
+  uint16_t *tx_stream;     // SSD1306_TX_STREAM_WORDS(w, h) palavras; NULL desabilita o DMA
+} ssd1306_framebuffer_t;
+
+// Define em tempo de compilação a memória de um display w x h (ex.: 128x64 ou
+// 128x32): SSD1306_FRAMEBUFFER(oled_fb, 128, 64); ssd1306_init(..., &oled_fb);
+#define SSD1306_FRAMEBUFFER(name, w, h)                                   \
+  static uint8_t name##_ram[SSD1306_BUFSIZE(w, h)];                       \
+  static uint8_t name##_shadow[SSD1306_BUFSIZE(w, h)];                    \
+  static uint16_t name##_tx[SSD1306_TX_STREAM_WORDS(w, h)];               \
+  static const ssd1306_framebuffer_t name = {name##_ram, name##_shadow, name##_tx}
+
 typedef struct {
   uint8_t width, height, pages, address;
   i2c_inst_t *i2c_port;
@@ -35,12 +70,34 @@ typedef struct {
   uint8_t *ram_buffer;
   size_t bufsize;
   uint8_t port_buffer[2];
+  // Faixa de colunas alterada em cada página desde o último envio
+  // (dirty_x0 > dirty_x1 indica página limpa)
+  uint8_t dirty_x0[SSD1306_MAX_PAGES];
+  uint8_t dirty_x1[SSD1306_MAX_PAGES];
+  // Cópia do que está na GDDRAM do display, no mesmo layout de ram_buffer.
+  // Permite descartar regiões apagadas e redesenhadas iguais (fill + redraw)
+  uint8_t *shadow_buffer;
+  bool shadow_valid;
+  // Envio assíncrono: o quadro é codificado em tx_stream e o DMA o entrega ao
+  // FIFO do I2C enquanto o próximo é desenhado em ram_buffer (dma_chan < 0:
+  // envio bloqueante)
+  int dma_chan;
+  uint16_t *tx_stream;
+  size_t tx_len;
+  bool flush_pending;
 } ssd1306_t;
 
-void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
+void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c,
+                  const ssd1306_framebuffer_t *fb);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_commands(ssd1306_t *ssd, const uint8_t *commands, size_t len);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_enable_dma(ssd1306_t *ssd);
+bool ssd1306_busy(ssd1306_t *ssd);
+void ssd1306_poll(ssd1306_t *ssd);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void ssd1306_mark_all_dirty(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -48,6 +105,9 @@ void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
+void ssd1306_scroll_left(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1, uint8_t n);
+uint8_t ssd1306_draw_glyph(ssd1306_t *ssd, const font_t *font, char c, uint8_t x, uint8_t y);
+uint16_t ssd1306_draw_text(ssd1306_t *ssd, const font_t *font, const char *str, uint8_t x, uint8_t y);
 void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
 
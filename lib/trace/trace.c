@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include "trace.h"
+
+#if TRACE_USE_SYSTICK
+#include "hardware/structs/systick.h"
+#define TRACE_UNIT "ciclos"
+#else
+#define TRACE_UNIT "us"
+#endif
+
+static const char *const op_names[TRACE_NUM_OPS] = {
+    [TRACE_SENSOR_READ] = "sensor_read",
+    [TRACE_RECORD_FORMAT] = "record_format",
+    [TRACE_F_WRITE] = "f_write",
+    [TRACE_DISK_WRITE] = "disk_write",
+    [TRACE_SD_WAIT_READY] = "sd_wait_ready",
+    [TRACE_SSD1306_SEND] = "ssd1306_send",
+};
+
+static trace_event_t ring[TRACE_RING_SIZE];
+static uint32_t ring_head = 0;  // Total de eventos já gravados
+static trace_stats_t stats[TRACE_NUM_OPS];
+
+void trace_init()
+{
+#if TRACE_USE_SYSTICK
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;  // Habilita, fonte = clk_sys, sem interrupção
+#endif
+    trace_reset();
+}
+
+void trace_reset()
+{
+    memset(ring, 0, sizeof(ring));
+    memset(stats, 0, sizeof(stats));
+    ring_head = 0;
+}
+
+uint32_t trace_now()
+{
+#if TRACE_USE_SYSTICK
+    // O SysTick conta para baixo; inverte para ficar crescente
+    return (0x00FFFFFF - systick_hw->cvr) & 0x00FFFFFF;
+#else
+    return time_us_32();
+#endif
+}
+
+// Índice do bucket log2: 0 para duração 0, k para [2^(k-1), 2^k)
+static inline uint32_t hist_bucket(uint32_t duration)
+{
+    uint32_t bucket = duration ? 32 - __builtin_clz(duration) : 0;
+    return bucket < TRACE_HIST_BUCKETS ? bucket : TRACE_HIST_BUCKETS - 1;
+}
+
+void trace_record(trace_op_t op, uint32_t start)
+{
+#if TRACE_USE_SYSTICK
+    uint32_t duration = (trace_now() - start) & 0x00FFFFFF;
+#else
+    uint32_t duration = trace_now() - start;
+#endif
+
+    trace_event_t *ev = &ring[ring_head++ & (TRACE_RING_SIZE - 1)];
+    ev->start = start;
+    ev->duration = duration;
+    ev->op = (uint8_t)op;
+
+    trace_stats_t *s = &stats[op];
+    if (s->count == 0 || duration < s->min)
+        s->min = duration;
+    if (duration > s->max)
+        s->max = duration;
+    s->count++;
+    s->total += duration;
+    s->hist[hist_bucket(duration)]++;
+}
+
+const trace_stats_t *trace_get_stats(trace_op_t op)
+{
+    return &stats[op];
+}
+
+void trace_dump()
+{
+    printf("\n==== Trace (%s) ====\n", TRACE_UNIT);
+    printf("%-14s %8s %10s %8s %8s %12s\n", "operacao", "qtd", "media", "min", "max", "total");
+    for (int op = 0; op < TRACE_NUM_OPS; op++) {
+        const trace_stats_t *s = &stats[op];
+        if (s->count == 0)
+            continue;
+        printf("%-14s %8lu %10lu %8lu %8lu %12llu\n", op_names[op],
+               (unsigned long)s->count, (unsigned long)(s->total / s->count),
+               (unsigned long)s->min, (unsigned long)s->max, (unsigned long long)s->total);
+    }
+
+    printf("\nHistogramas log2 (bucket: [2^(k-1), 2^k) %s)\n", TRACE_UNIT);
+    for (int op = 0; op < TRACE_NUM_OPS; op++) {
+        const trace_stats_t *s = &stats[op];
+        if (s->count == 0)
+            continue;
+        printf("%s:", op_names[op]);
+        for (int k = 0; k < TRACE_HIST_BUCKETS; k++)
+            if (s->hist[k])
+                printf(" <%lu:%lu", 1ul << k, (unsigned long)s->hist[k]);
+        printf("\n");
+    }
+
+    uint32_t n = ring_head < TRACE_RING_SIZE ? ring_head : TRACE_RING_SIZE;
+    uint32_t shown = n < 16 ? n : 16;
+    printf("\nUltimos %lu eventos:\n", (unsigned long)shown);
+    for (uint32_t i = ring_head - shown; i != ring_head; i++) {
+        const trace_event_t *ev = &ring[i & (TRACE_RING_SIZE - 1)];
+        printf("%10lu %-14s %lu\n", (unsigned long)ev->start, op_names[ev->op], (unsigned long)ev->duration);
+    }
+    printf("==== Fim do trace ====\n\n");
+}
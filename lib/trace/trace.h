@@ -0,0 +1,77 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+
+// Instrumentação leve do caminho crítico: cada operação marcada com
+// TRACE_BEGIN/TRACE_END gera um evento no buffer circular e incrementa o
+// histograma log2 da sua duração. Compilar com DATALOGGER_TRACE=0 remove tudo.
+//
+// Por padrão a base de tempo é time_us_32() (us). Com TRACE_USE_SYSTICK=1 usa
+// o SysTick em ciclos de clk_sys; nesse modo operações acima de 2^24 ciclos
+// (~134 ms a 125 MHz) dão a volta no contador e são medidas errado.
+
+#ifndef DATALOGGER_TRACE
+#define DATALOGGER_TRACE 1
+#endif
+
+#ifndef TRACE_USE_SYSTICK
+#define TRACE_USE_SYSTICK 0
+#endif
+
+#define TRACE_RING_SIZE 256    // Potência de 2
+#define TRACE_HIST_BUCKETS 32  // Bucket k: duração em [2^(k-1), 2^k)
+
+typedef enum {
+    TRACE_SENSOR_READ,
+    TRACE_RECORD_FORMAT,
+    TRACE_F_WRITE,
+    TRACE_DISK_WRITE,
+    TRACE_SD_WAIT_READY,
+    TRACE_SSD1306_SEND,
+    TRACE_NUM_OPS
+} trace_op_t;
+
+typedef struct {
+    uint32_t start;
+    uint32_t duration;
+    uint8_t op;
+} trace_event_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t total;
+    uint32_t hist[TRACE_HIST_BUCKETS];
+} trace_stats_t;
+
+// Inicializa a base de tempo e zera as estatísticas
+void trace_init();
+
+// Zera buffer circular e histogramas
+void trace_reset();
+
+// Instante atual na base de tempo do trace
+uint32_t trace_now();
+
+// Registra uma operação iniciada em start (valor de trace_now())
+void trace_record(trace_op_t op, uint32_t start);
+
+// Estatísticas acumuladas de uma operação
+const trace_stats_t *trace_get_stats(trace_op_t op);
+
+// Imprime estatísticas, histogramas e os últimos eventos no stdio USB
+void trace_dump();
+
+#if DATALOGGER_TRACE
+#define TRACE_BEGIN(var) uint32_t var = trace_now()
+#define TRACE_END(op, var) trace_record((op), (var))
+#else
+#define TRACE_BEGIN(var)
+#define TRACE_END(op, var)
+#endif
+
+#endif // TRACE_H
@@ -0,0 +1,98 @@
+#include <string.h>
+#include "graph.h"
+
+#define GRAPH_X1 (GRAPH_X0 + GRAPH_WIDTH - 1)
+#define GRAPH_Y0 (GRAPH_PAGE0 * 8)
+#define GRAPH_HEIGHT (GRAPH_PAGES * 8)
+
+static void reset_acc(graph_t *graph)
+{
+    for (uint8_t c = 0; c < graph->num_channels; ++c) {
+        graph->acc[c].min = INT16_MAX;
+        graph->acc[c].max = INT16_MIN;
+    }
+    graph->acc_samples = 0;
+}
+
+void graph_init(graph_t *graph, uint8_t num_channels, const int16_t *range)
+{
+    memset(graph, 0, sizeof(*graph));
+    if (num_channels == 0)
+        num_channels = 1;
+    if (num_channels > GRAPH_MAX_CHANNELS)
+        num_channels = GRAPH_MAX_CHANNELS;
+
+    graph->num_channels = num_channels;
+    for (uint8_t c = 0; c < num_channels; ++c)
+        graph->range[c] = range[c] > 0 ? range[c] : INT16_MAX;
+    reset_acc(graph);
+}
+
+void graph_push(graph_t *graph, const int16_t *values)
+{
+    for (uint8_t c = 0; c < graph->num_channels; ++c) {
+        if (values[c] < graph->acc[c].min)
+            graph->acc[c].min = values[c];
+        if (values[c] > graph->acc[c].max)
+            graph->acc[c].max = values[c];
+    }
+    graph->acc_samples++;
+}
+
+bool graph_has_pending(const graph_t *graph)
+{
+    return graph->acc_samples != 0;
+}
+
+// Linha da tela para um valor do canal c (valores maiores ficam mais acima)
+static uint8_t value_to_y(const graph_t *graph, uint8_t c, int16_t value)
+{
+    uint8_t strip = GRAPH_HEIGHT / graph->num_channels;
+    int32_t range = graph->range[c];
+    int32_t v = value < -range ? -range : (value > range ? range : value);
+    int32_t offset = (v + range) * (strip - 1) / (2 * range);
+
+    return (uint8_t)(GRAPH_Y0 + c * strip + (strip - 1) - offset);
+}
+
+static void draw_column(graph_t *graph, ssd1306_t *ssd, uint8_t x, const graph_bucket_t *bucket)
+{
+    for (uint8_t c = 0; c < graph->num_channels; ++c)
+        ssd1306_vline(ssd, x, value_to_y(graph, c, bucket[c].max), value_to_y(graph, c, bucket[c].min), true);
+}
+
+void graph_clear(graph_t *graph, ssd1306_t *ssd)
+{
+    ssd1306_rect(ssd, GRAPH_Y0, GRAPH_X0, GRAPH_WIDTH, GRAPH_HEIGHT, false, true);
+    graph->drawn = false;
+}
+
+void graph_render(graph_t *graph, ssd1306_t *ssd)
+{
+    bool new_column = graph->acc_samples != 0;
+
+    if (new_column) {
+        memcpy(graph->history[graph->head], graph->acc, sizeof(graph->history[0]));
+        graph->head = (graph->head + 1) % GRAPH_WIDTH;
+        if (graph->filled < GRAPH_WIDTH)
+            graph->filled++;
+        reset_acc(graph);
+    }
+
+    if (graph->drawn) {
+        // Scroll incremental: só a coluna mais recente é desenhada
+        if (new_column) {
+            ssd1306_scroll_left(ssd, GRAPH_X0, GRAPH_X1, GRAPH_PAGE0, GRAPH_PAGE0 + GRAPH_PAGES - 1, 1);
+            draw_column(graph, ssd, GRAPH_X1, graph->history[(graph->head + GRAPH_WIDTH - 1) % GRAPH_WIDTH]);
+        }
+        return;
+    }
+
+    // Redesenho completo a partir do histórico, alinhado à direita
+    graph_clear(graph, ssd);
+    for (uint8_t i = 0; i < graph->filled; ++i) {
+        uint8_t slot = (graph->head + GRAPH_WIDTH - graph->filled + i) % GRAPH_WIDTH;
+        draw_column(graph, ssd, GRAPH_X1 - graph->filled + 1 + i, graph->history[slot]);
+    }
+    graph->drawn = true;
+}
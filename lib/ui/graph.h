@@ -0,0 +1,54 @@
+#ifndef GRAPH_H
+#define GRAPH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "ssd1306/ssd1306.h"
+
+// Gráfico de linha rolante (sparkline) para canais do sensor. As amostras
+// chegam na taxa de aquisição por graph_push(), que só acumula mínimo e
+// máximo; a cada quadro do display graph_render() fecha esse intervalo em uma
+// coluna, desloca o gráfico uma coluna para a esquerda e desenha apenas a
+// coluna nova (uma barra de mínimo a máximo por canal).
+
+// Área do corpo entre as divisórias da UI: páginas 2 a 5 (y = 16..47)
+#define GRAPH_X0 4
+#define GRAPH_WIDTH 120
+#define GRAPH_PAGE0 2
+#define GRAPH_PAGES 4
+#define GRAPH_MAX_CHANNELS 3
+
+typedef struct {
+    int16_t min;
+    int16_t max;
+} graph_bucket_t;
+
+typedef struct {
+    uint8_t num_channels;                    // Cada canal ocupa uma faixa horizontal
+    int16_t range[GRAPH_MAX_CHANNELS];       // Meia escala: valores em [-range, range]
+    graph_bucket_t acc[GRAPH_MAX_CHANNELS];  // Intervalo em formação
+    uint32_t acc_samples;
+    graph_bucket_t history[GRAPH_WIDTH][GRAPH_MAX_CHANNELS];  // Colunas exibidas (anel)
+    uint8_t head;    // Próxima posição do anel
+    uint8_t filled;  // Colunas válidas no anel
+    bool drawn;      // Conteúdo atual está no framebuffer (permite o scroll incremental)
+} graph_t;
+
+// Configura n canais (1..GRAPH_MAX_CHANNELS) com as meias escalas indicadas
+void graph_init(graph_t *graph, uint8_t num_channels, const int16_t *range);
+
+// Acumula uma amostra (um valor por canal); O(canais), sem acessar o display
+void graph_push(graph_t *graph, const int16_t *values);
+
+// Há amostras novas para virar coluna
+bool graph_has_pending(const graph_t *graph);
+
+// Fecha o intervalo atual e atualiza o gráfico no framebuffer; redesenha tudo
+// a partir do histórico se o gráfico não estiver desenhado
+void graph_render(graph_t *graph, ssd1306_t *ssd);
+
+// Apaga a área do gráfico (ex.: ao sair do modo gráfico)
+void graph_clear(graph_t *graph, ssd1306_t *ssd);
+
+#endif // GRAPH_H
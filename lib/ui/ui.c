@@ -0,0 +1,211 @@
+#include <stdio.h>
+#include <string.h>
+#include "ui.h"
+
+void ui_init(ui_screen_t *ui)
+{
+    memset(ui, 0, sizeof(*ui));
+
+    for (int i = 0; i < UI_NUM_WIDGETS; ++i)
+        ui->widgets[i].font = &font_prop;
+    ui->widgets[UI_FIELD_VALUE].font = &font_digits_2x;
+
+    ui->widgets[UI_FIELD_LABEL].body = true;
+    ui->widgets[UI_FIELD_VALUE].body = true;
+    ui->widgets[UI_IDLE_TEXT].body = true;
+
+    ui_set_text(ui, UI_FIELD_LABEL, "Amostras:", 20);
+    ui_set_text(ui, UI_FIELD_VALUE, "0", 30);
+    ui_set_text(ui, UI_IDLE_TEXT, "Aguardando...", 30);
+    ui_set_visible(ui, UI_FIELD_LABEL, false);
+    ui_set_visible(ui, UI_FIELD_VALUE, false);
+    ui_set_visible(ui, UI_IDLE_TEXT, false);
+}
+
+void ui_set_text(ui_screen_t *ui, ui_widget_id_t id, const char *text, uint8_t y)
+{
+    ui_widget_t *w = &ui->widgets[id];
+
+    if (!text)
+        text = "";
+    strncpy(w->text, text, UI_TEXT_MAX - 1);
+    w->text[UI_TEXT_MAX - 1] = '\0';
+    w->y = y;
+    w->width = font_text_width(w->font, w->text);
+    w->visible = w->text[0] != '\0';
+    w->has_number = false;
+}
+
+void ui_set_font(ui_screen_t *ui, ui_widget_id_t id, const font_t *font)
+{
+    ui_widget_t *w = &ui->widgets[id];
+
+    w->font = font;
+    w->width = font_text_width(font, w->text);
+}
+
+void ui_set_number(ui_screen_t *ui, ui_widget_id_t id, int value)
+{
+    ui_widget_t *w = &ui->widgets[id];
+
+    if (w->has_number && w->number == value)
+        return;
+    snprintf(w->text, sizeof(w->text), "%d", value);
+    w->width = font_text_width(w->font, w->text);
+    w->number = value;
+    w->has_number = true;
+}
+
+void ui_set_visible(ui_screen_t *ui, ui_widget_id_t id, bool visible)
+{
+    ui->widgets[id].visible = visible;
+}
+
+void ui_show_message(ui_screen_t *ui, const char *line0, uint8_t y0, const char *line1, uint8_t y1)
+{
+    ui_set_text(ui, UI_MESSAGE_0, line0, y0);
+    ui_set_text(ui, UI_MESSAGE_1, line1, y1);
+    ui->message_active = true;
+}
+
+void ui_hide_message(ui_screen_t *ui)
+{
+    ui_set_visible(ui, UI_MESSAGE_0, false);
+    ui_set_visible(ui, UI_MESSAGE_1, false);
+    ui->message_active = false;
+}
+
+void ui_show_graph(ui_screen_t *ui, graph_t *graph)
+{
+    if (ui->graph == graph)
+        return;
+    if (ui->graph && ui->graph->drawn)
+        ui->graph_leftover = true;
+    ui->graph = graph;
+    if (graph)
+        graph->drawn = false;
+}
+
+void ui_invalidate(ui_screen_t *ui)
+{
+    ui->chrome_drawn = false;
+    for (int i = 0; i < UI_NUM_WIDGETS; ++i)
+        ui->widgets[i].drawn = false;
+}
+
+static void draw_chrome(ssd1306_t *ssd)
+{
+    static const char title[] = "DATALOGGER";
+
+    ssd1306_fill(ssd, false);
+    ssd1306_rect(ssd, 3, 3, 122, 60, true, false);
+    ssd1306_line(ssd, 3, 15, 123, 15, true);   // Após título
+    ssd1306_draw_text(ssd, &font_prop, title, (128 - font_text_width(&font_prop, title)) / 2, 6);
+    ssd1306_line(ssd, 3, 48, 123, 48, true);   // Antes do status
+}
+
+static inline bool is_shown(const ui_screen_t *ui, const ui_widget_t *w)
+{
+    return w->visible && w->text[0] != '\0' && !(w->body && (ui->message_active || ui->graph));
+}
+
+static inline uint8_t text_x(const ui_widget_t *w)
+{
+    return w->width >= 128 ? 0 : (uint8_t)((128 - w->width) / 2);
+}
+
+// Retângulo ocupado pelo texto atual, recortado à área interna da moldura
+static void text_span(const ui_widget_t *w, uint8_t *x0, uint8_t *x1)
+{
+    uint16_t start = text_x(w);
+    uint16_t end = start + w->width - 1;
+
+    *x0 = start < UI_CLIP_X0 ? UI_CLIP_X0 : (uint8_t)start;
+    *x1 = end > UI_CLIP_X1 ? UI_CLIP_X1 : (uint8_t)end;
+}
+
+typedef struct {
+    uint8_t x0, x1, y, h;
+} ui_area_t;
+
+static bool overlaps(const ui_widget_t *w, const ui_area_t *a)
+{
+    return w->drawn_x0 <= a->x1 && a->x0 <= w->drawn_x1 &&
+           w->drawn_y < a->y + a->h && a->y < w->drawn_y + w->drawn_h;
+}
+
+void ui_render(ui_screen_t *ui, ssd1306_t *ssd)
+{
+    // Áreas apagadas neste quadro; widgets visíveis sobre elas são redesenhados
+    ui_area_t erased[UI_NUM_WIDGETS];
+    int num_erased = 0;
+    bool changed[UI_NUM_WIDGETS];
+
+    if (!ui->chrome_drawn) {
+        draw_chrome(ssd);
+        ui->chrome_drawn = true;
+        for (int i = 0; i < UI_NUM_WIDGETS; ++i)
+            ui->widgets[i].drawn = false;
+        if (ui->graph)
+            ui->graph->drawn = false;
+    }
+
+    // 1) Apaga o que mudou de texto/fonte/posição ou deixou de ser exibido.
+    //    Glifos são opacos: um texto novo que cobre o retângulo antigo dispensa apagar
+    for (int i = 0; i < UI_NUM_WIDGETS; ++i) {
+        ui_widget_t *w = &ui->widgets[i];
+        bool shown = is_shown(ui, w);
+
+        changed[i] = shown != w->drawn ||
+                     (shown && (w->y != w->drawn_y || w->font != w->drawn_font ||
+                                strcmp(w->text, w->drawn_text) != 0));
+        if (!changed[i] || !w->drawn)
+            continue;
+
+        if (shown && w->y == w->drawn_y && w->font->height >= w->drawn_h) {
+            uint8_t new_x0, new_x1;
+            text_span(w, &new_x0, &new_x1);
+            if (new_x0 <= w->drawn_x0 && new_x1 >= w->drawn_x1)
+                continue;
+        }
+
+        ssd1306_rect(ssd, w->drawn_y, w->drawn_x0, w->drawn_x1 - w->drawn_x0 + 1, w->drawn_h, false, true);
+        erased[num_erased++] = (ui_area_t){ w->drawn_x0, w->drawn_x1, w->drawn_y, w->drawn_h };
+        w->drawn = false;
+    }
+
+    // O gráfico ocupa a área do corpo; a mensagem temporária o encobre
+    if (ui->graph_leftover) {
+        ssd1306_rect(ssd, GRAPH_PAGE0 * 8, GRAPH_X0, GRAPH_WIDTH, GRAPH_PAGES * 8, false, true);
+        ui->graph_leftover = false;
+    }
+    if (ui->graph) {
+        if (!ui->message_active)
+            graph_render(ui->graph, ssd);
+        else if (ui->graph->drawn)
+            graph_clear(ui->graph, ssd);
+    }
+
+    // 2) Desenha os widgets alterados e os atingidos por alguma área apagada
+    for (int i = 0; i < UI_NUM_WIDGETS; ++i) {
+        ui_widget_t *w = &ui->widgets[i];
+        if (!is_shown(ui, w))
+            continue;
+
+        bool redraw = changed[i];
+        for (int e = 0; e < num_erased && !redraw && w->drawn; ++e)
+            redraw = overlaps(w, &erased[e]);
+        if (!redraw)
+            continue;
+
+        ssd1306_draw_text(ssd, w->font, w->text, text_x(w), w->y);
+        memcpy(w->drawn_text, w->text, sizeof(w->drawn_text));
+        w->drawn_font = w->font;
+        text_span(w, &w->drawn_x0, &w->drawn_x1);
+        w->drawn_y = w->y;
+        w->drawn_h = w->font->height;
+        w->drawn = true;
+    }
+
+    ssd1306_send_data(ssd);
+}
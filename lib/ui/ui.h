@@ -0,0 +1,86 @@
+#ifndef UI_H
+#define UI_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico/stdlib.h"
+#include "ssd1306/ssd1306.h"
+#include "graph.h"
+
+// Camada de interface em modo retido sobre o SSD1306: a moldura (borda, título
+// e divisórias) é desenhada uma vez e cada widget guarda o que está na tela.
+// ui_render() apaga e redesenha só os widgets cujo conteúdo mudou, de modo que
+// o flush por regiões sujas envia apenas a linha de glifos alterada.
+// Cada widget tem sua fonte; a largura do texto é calculada ao alterá-lo, e
+// não a cada quadro, e o retângulo desenhado fica guardado para o apagamento.
+
+#define UI_TEXT_MAX 17   // 16 caracteres de 8 px + '\0'
+
+// Área interna da moldura; widgets nunca apagam fora dela
+#define UI_CLIP_X0 4
+#define UI_CLIP_X1 123
+
+typedef enum {
+    UI_FIELD_LABEL,   // Rótulo do campo numérico ("Amostras:")
+    UI_FIELD_VALUE,   // Valor do campo numérico
+    UI_IDLE_TEXT,     // Texto do corpo fora da captura ("Aguardando...")
+    UI_MESSAGE_0,     // Linhas da mensagem temporária (sobrepõe o corpo)
+    UI_MESSAGE_1,
+    UI_STATUS,        // Linha de status na parte inferior
+    UI_NUM_WIDGETS
+} ui_widget_id_t;
+
+// Texto centralizado em uma linha
+typedef struct {
+    char text[UI_TEXT_MAX];
+    const font_t *font;
+    uint16_t width;          // Largura do texto na fonte do widget
+    uint8_t y;
+    bool visible;
+    bool body;               // Fica oculto com mensagem ou gráfico ativos
+    int number;              // Último valor de ui_set_number() (evita formatar de novo)
+    bool has_number;
+
+    // Estado desenhado no framebuffer (retângulo já recortado à moldura)
+    char drawn_text[UI_TEXT_MAX];
+    const font_t *drawn_font;
+    uint8_t drawn_x0, drawn_x1, drawn_y, drawn_h;
+    bool drawn;
+} ui_widget_t;
+
+typedef struct {
+    ui_widget_t widgets[UI_NUM_WIDGETS];
+    bool message_active;
+    graph_t *graph;          // Gráfico exibido no lugar do corpo (NULL = nenhum)
+    bool graph_leftover;     // Gráfico removido ainda desenhado no framebuffer
+    bool chrome_drawn;
+} ui_screen_t;
+
+// Configura os widgets; a moldura é desenhada no primeiro ui_render()
+void ui_init(ui_screen_t *ui);
+
+// Altera texto/posição de um widget (NULL ou "" o oculta)
+void ui_set_text(ui_screen_t *ui, ui_widget_id_t id, const char *text, uint8_t y);
+
+// Fonte usada pelo widget (padrão: font_prop)
+void ui_set_font(ui_screen_t *ui, ui_widget_id_t id, const font_t *font);
+
+// Campo numérico: só formata quando o valor muda
+void ui_set_number(ui_screen_t *ui, ui_widget_id_t id, int value);
+
+void ui_set_visible(ui_screen_t *ui, ui_widget_id_t id, bool visible);
+
+// Mensagem temporária de até duas linhas sobre o corpo (line NULL = sem texto)
+void ui_show_message(ui_screen_t *ui, const char *line0, uint8_t y0, const char *line1, uint8_t y1);
+void ui_hide_message(ui_screen_t *ui);
+
+// Troca o corpo pelo gráfico (NULL volta ao corpo de texto)
+void ui_show_graph(ui_screen_t *ui, graph_t *graph);
+
+// Força o redesenho completo (ex.: após limpar o display por fora da UI)
+void ui_invalidate(ui_screen_t *ui);
+
+// Redesenha os widgets alterados e envia as regiões sujas ao display
+void ui_render(ui_screen_t *ui, ssd1306_t *ssd);
+
+#endif // UI_H
@@ -2,10 +2,12 @@
 
 #include "pico/stdlib.h"
 #include <stdio.h>
+#include <string.h>
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "hardware/timer.h"
-
-int timeout = 26100;
+#include "ultrasonic.h"
 
 void setupUltrasonicPins(uint trigPin, uint echoPin)
 {
@@ -21,29 +23,216 @@ uint64_t getPulse(uint trigPin, uint echoPin)
     sleep_us(10);
     gpio_put(trigPin, 0);
 
-    uint64_t width = 0;
-
-    while (gpio_get(echoPin) == 0) tight_loop_contents();
+    // Sem sensor (ou sem eco) a borda de subida nunca chega
+    absolute_time_t riseTimeout = make_timeout_time_us(ULTRASONIC_TIMEOUT_US);
+    while (gpio_get(echoPin) == 0)
+    {
+        if (time_reached(riseTimeout)) return 0;
+        tight_loop_contents();
+    }
+    // A largura vem dos carimbos de tempo, não da contagem de iterações
     absolute_time_t startTime = get_absolute_time();
-    while (gpio_get(echoPin) == 1) 
+    absolute_time_t fallTimeout = delayed_by_us(startTime, ULTRASONIC_TIMEOUT_US);
+    while (gpio_get(echoPin) == 1)
     {
-        width++;
-        sleep_us(1);
-        if (width > timeout) return 0;
+        if (time_reached(fallTimeout)) return 0;
+        tight_loop_contents();
     }
     absolute_time_t endTime = get_absolute_time();
-    
+
     return absolute_time_diff_us(startTime, endTime);
 }
 
 uint64_t getCm(uint trigPin, uint echoPin)
 {
     uint64_t pulseLength = getPulse(trigPin, echoPin);
-    return pulseLength / 29 / 2;
+    return (ultrasonic_pulse_to_mm((uint32_t)pulseLength) + 5) / 10;
 }
 
 uint64_t getInch(uint trigPin, uint echoPin)
 {
     uint64_t pulseLength = getPulse(trigPin, echoPin);
-    return (long)pulseLength / 74.f / 2.f;
-}
\ No newline at end of file
+    return (ultrasonic_pulse_to_mm((uint32_t)pulseLength) * 10 + 127) / 254;
+}
+
+int32_t ultrasonic_pulse_to_mm(uint32_t pulse_us)
+{
+    // mm = pulse * 343 / 2000 (ida e volta)
+    return (int32_t)(((uint64_t)pulse_us * ULTRASONIC_SOUND_SPEED + 1000) / 2000);
+}
+
+// ---------------------------------------------------------------------------
+// Captura por interrupção
+// ---------------------------------------------------------------------------
+
+static ultrasonic_t *devices[ULTRASONIC_MAX_DEVICES];
+static uint num_devices;
+
+// Carimba as bordas do eco; roda na interrupção IO_IRQ_BANK0
+static void ultrasonic_echo_irq(void)
+{
+    uint32_t now = time_us_32();
+
+    for (uint i = 0; i < num_devices; i++)
+    {
+        ultrasonic_t *dev = devices[i];
+        uint32_t events = gpio_get_irq_event_mask(dev->echo_pin) & (GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+        if (!events) continue;
+        gpio_acknowledge_irq(dev->echo_pin, events);
+
+        if ((events & GPIO_IRQ_EDGE_RISE) && dev->state == ULTRASONIC_WAIT_RISE)
+        {
+            dev->rise_us = now;
+            dev->state = ULTRASONIC_WAIT_FALL;
+        }
+        if ((events & GPIO_IRQ_EDGE_FALL) && dev->state == ULTRASONIC_WAIT_FALL)
+        {
+            dev->fall_us = now;
+            dev->state = ULTRASONIC_DONE;
+        }
+    }
+}
+
+// Sensor registrado com o pino de eco, ou NULL
+static ultrasonic_t *find_device(uint echo_pin)
+{
+    for (uint i = 0; i < num_devices; i++)
+    {
+        if (devices[i]->echo_pin == echo_pin) return devices[i];
+    }
+    return NULL;
+}
+
+void ultrasonic_reset(ultrasonic_t *dev)
+{
+    // Com a interrupção do eco mascarada, a IRQ não vê o estado pela metade
+    gpio_set_irq_enabled(dev->echo_pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, false);
+    dev->state = ULTRASONIC_IDLE;
+    dev->rise_us = 0;
+    dev->fall_us = 0;
+    dev->trigger_us = 0;
+    gpio_acknowledge_irq(dev->echo_pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL);
+    gpio_set_irq_enabled(dev->echo_pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+}
+
+bool ultrasonic_begin(ultrasonic_t *dev, uint trig_pin, uint echo_pin)
+{
+    // Reinicialização (escalonador): a interrupção já está instalada e só a
+    // captura volta ao repouso
+    ultrasonic_t *registered = find_device(echo_pin);
+    if (registered == dev && dev->trig_pin == trig_pin)
+    {
+        ultrasonic_reset(dev);
+        return true;
+    }
+    if (registered || num_devices >= ULTRASONIC_MAX_DEVICES) return false;
+
+    memset(dev, 0, sizeof(*dev));
+    dev->trig_pin = trig_pin;
+    dev->echo_pin = echo_pin;
+    dev->state = ULTRASONIC_IDLE;
+    setupUltrasonicPins(trig_pin, echo_pin);
+
+    devices[num_devices++] = dev;
+    gpio_add_raw_irq_handler(echo_pin, ultrasonic_echo_irq);
+    gpio_set_irq_enabled(echo_pin, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+    return true;
+}
+
+bool ultrasonic_trigger(ultrasonic_t *dev)
+{
+    // O HC-SR04 ignora o gatilho enquanto o eco anterior está alto
+    if (gpio_get(dev->echo_pin)) return false;
+
+    dev->state = ULTRASONIC_WAIT_RISE;
+    gpio_put(dev->trig_pin, 1);
+    busy_wait_us(10);
+    gpio_put(dev->trig_pin, 0);
+    dev->trigger_us = time_us_32();
+    return true;
+}
+
+ultrasonic_state_t ultrasonic_poll(ultrasonic_t *dev)
+{
+    uint32_t now = time_us_32();
+    ultrasonic_state_t state = dev->state;
+
+    // As bordas podem chegar entre a leitura do estado e a do carimbo; o
+    // estado lido antes decide qual prazo vale
+    if ((state == ULTRASONIC_WAIT_RISE && now - dev->trigger_us > ULTRASONIC_TIMEOUT_US) ||
+        (state == ULTRASONIC_WAIT_FALL && now - dev->rise_us > ULTRASONIC_TIMEOUT_US))
+    {
+        uint32_t irq = save_and_disable_interrupts();
+        if (dev->state == state)
+        {
+            dev->state = ULTRASONIC_TIMEOUT;
+            dev->timeouts++;
+        }
+        restore_interrupts(irq);
+    }
+    return dev->state;
+}
+
+uint32_t ultrasonic_pulse_us(const ultrasonic_t *dev)
+{
+    return dev->fall_us - dev->rise_us;
+}
+
+// ---------------------------------------------------------------------------
+// Interface de sensor
+// ---------------------------------------------------------------------------
+
+static const sensor_channel_t ultrasonic_channels[] = {
+    {"Dist_cm", 1},
+};
+
+static bool ultrasonic_sensor_init(sensor_t *s)
+{
+    return ultrasonic_begin(s->ctx, ULTRASONIC_TRIG_PIN, ULTRASONIC_ECHO_PIN);
+}
+
+static bool ultrasonic_sensor_start(sensor_t *s)
+{
+    return ultrasonic_trigger(s->ctx);
+}
+
+// Pronto quando o pulso foi medido ou o prazo venceu; read() separa os casos
+static bool ultrasonic_sensor_ready(sensor_t *s)
+{
+    ultrasonic_state_t state = ultrasonic_poll(s->ctx);
+    return state == ULTRASONIC_DONE || state == ULTRASONIC_TIMEOUT;
+}
+
+static bool ultrasonic_sensor_read(sensor_t *s, uint8_t *raw)
+{
+    ultrasonic_t *dev = s->ctx;
+
+    if (dev->state != ULTRASONIC_DONE) return false;
+    uint32_t pulse = ultrasonic_pulse_us(dev);
+    dev->state = ULTRASONIC_IDLE;
+    memcpy(raw, &pulse, sizeof(pulse));
+    return true;
+}
+
+static void ultrasonic_sensor_decode(sensor_t *s, const uint8_t *raw, int32_t *values)
+{
+    uint32_t pulse;
+    (void)s;
+
+    memcpy(&pulse, raw, sizeof(pulse));
+    values[0] = ultrasonic_pulse_to_mm(pulse);
+}
+
+const sensor_driver_t ultrasonic_sensor = {
+    .name = "HC-SR04",
+    .channels = ultrasonic_channels,
+    .num_channels = 1,
+    .period_us = 500000,
+    .conversion_us = 0,
+    .init = ultrasonic_sensor_init,
+    .start = ultrasonic_sensor_start,
+    .ready = ultrasonic_sensor_ready,
+    .read = ultrasonic_sensor_read,
+    .decode = ultrasonic_sensor_decode,
+};
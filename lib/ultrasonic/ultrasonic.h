@@ -1,6 +1,76 @@
 #ifndef ultrasonic_h
 #define ultrasonic_h
-void setupUltrasonicPins(int trigPin, int echoPin);
-int getCm(int trigPin, int echoPin);
-int getInch(int trigPin, int echoPin);
-#endif
\ No newline at end of file
+
+#include <stdint.h>
+#include "pico/stdlib.h"
+#include "sensor/sensor.h"
+
+// Pinos do HC-SR04 (o eco de 5 V passa por um divisor resistivo)
+#define ULTRASONIC_TRIG_PIN 8
+#define ULTRASONIC_ECHO_PIN 9
+
+// Maior espera por cada borda do eco (~4,5 m ida e volta)
+#define ULTRASONIC_TIMEOUT_US 26100
+
+// Velocidade do som a 20 °C, em m/s (= mm/ms)
+#define ULTRASONIC_SOUND_SPEED 343
+
+// Sensores com captura por interrupção (um por pino de eco)
+#define ULTRASONIC_MAX_DEVICES 2
+
+void setupUltrasonicPins(uint trigPin, uint echoPin);
+
+// Largura do pulso de eco em us; 0 se o eco não começar ou não terminar
+// dentro de ULTRASONIC_TIMEOUT_US. Bloqueia durante toda a medição.
+uint64_t getPulse(uint trigPin, uint echoPin);
+uint64_t getCm(uint trigPin, uint echoPin);
+uint64_t getInch(uint trigPin, uint echoPin);
+
+// Captura sem espera: as bordas do eco são carimbadas com time_us_32() numa
+// interrupção de GPIO; o laço principal só dispara e confere o resultado.
+typedef enum {
+    ULTRASONIC_IDLE,
+    ULTRASONIC_WAIT_RISE,      // Gatilho enviado, eco ainda não começou
+    ULTRASONIC_WAIT_FALL,      // Eco em andamento
+    ULTRASONIC_DONE,           // Pulso medido
+    ULTRASONIC_TIMEOUT         // Eco não começou ou não terminou a tempo
+} ultrasonic_state_t;
+
+typedef struct {
+    uint trig_pin;
+    uint echo_pin;
+    volatile ultrasonic_state_t state;
+    volatile uint32_t rise_us;     // Carimbos das bordas (time_us_32)
+    volatile uint32_t fall_us;
+    uint32_t trigger_us;
+
+    uint32_t timeouts;
+} ultrasonic_t;
+
+// Configura os pinos e a interrupção das bordas do eco. Chamada de novo para
+// o mesmo sensor e pinos (reinicialização pelo escalonador), só faz
+// ultrasonic_reset(); false se a tabela estiver cheia ou o pino de eco já
+// pertencer a outro sensor.
+bool ultrasonic_begin(ultrasonic_t *dev, uint trig_pin, uint echo_pin);
+
+// Descarta a medição em andamento e volta ao repouso, mantendo os contadores
+void ultrasonic_reset(ultrasonic_t *dev);
+
+// Envia o pulso de gatilho (10 us); false se o eco anterior ainda estiver alto
+bool ultrasonic_trigger(ultrasonic_t *dev);
+
+// Aplica os prazos e retorna o estado da medição
+ultrasonic_state_t ultrasonic_poll(ultrasonic_t *dev);
+
+// Largura do último pulso medido, em us
+uint32_t ultrasonic_pulse_us(const ultrasonic_t *dev);
+
+// Distância em mm para um pulso de eco (ida e volta), arredondada
+int32_t ultrasonic_pulse_to_mm(uint32_t pulse_us);
+
+// Sensor para o escalonador (ctx: ultrasonic_t): Dist_cm com uma casa
+// decimal. O gatilho é enviado num período e o pulso é coletado quando a
+// interrupção marca a borda de descida, sem espera ativa.
+extern const sensor_driver_t ultrasonic_sensor;
+
+#endif
@@ -8,19 +8,36 @@
 
 #include "lib/button/button.h"
 #include "lib/mpu6050/mpu6050.h"
+#include "lib/bmp280/bmp280.h"
+#include "lib/aht20/aht20.h"
+#include "lib/ultrasonic/ultrasonic.h"
+#include "lib/sensor/sensor.h"
+#include "lib/i2c_bus/i2c_bus.h"
+#include "lib/i2c_bus/i2c_async.h"
 #include "lib/ssd1306/ssd1306.h"
 #include "lib/ssd1306/display.h"
 #include "lib/sd_card/sd_card_i.h"
 #include "lib/led/led.h"
 #include "lib/buzzer/buzzer.h"
+#include "lib/trace/trace.h"
+#include "lib/live_stream/live_stream.h"
+#include "lib/ui/ui.h"
 
 #define DEBOUNCE_TIME_US 200000
+#define DISPLAY_STORAGE_WATERMARK (LOG_SECTOR_SIZE * 3 / 4)  // Bytes pendentes no logger
+#define GRAPH_ACCEL_RANGE 32767  // Meia escala do gráfico: ±2 g (escala padrão do MPU6050)
+#define GRAPH_GYRO_RANGE 4096    // Meia escala do gráfico: ±31 °/s
+#define MAIN_LOOP_MAX_SLEEP_US 50000  // Botões, console e display entre amostras
+#define HEALTH_RECORD_INTERVAL_US 10000000  // Mínimo entre registros de falhas durante a captura
 
 void gpio_irq_callback(uint gpio, uint32_t events);
 void update_led_state();
 void update_display(ssd1306_t *ssd);
 void beep_start_capture();
 void beep_stop_capture();
+void handle_console_command();
+void init_sensors();
+void save_health_record(bool force);
 
 static char filename[20] = "data.txt";
 volatile static int64_t last_time_btn_a_pressed = 0;
@@ -29,6 +46,7 @@ volatile static int64_t last_time_btn_sw_pressed = 0;
 volatile static bool is_mounted = false;
 volatile static bool is_capture_mode = false;
 volatile static int num_samples = 0;
+volatile static int lost_records = 0;  // Registros descartados por falha do cartão na captura
 static int last_num_samples = -1;
 static bool last_is_mounted = false;
 static bool last_is_capturing = false;
@@ -40,19 +58,47 @@ volatile static bool should_beep_start = false;
 volatile static bool should_beep_stop = false;
 volatile static bool should_read_file = false;
 volatile static bool is_reading = false;
+static ui_screen_t ui;
+static display_sched_t display_sched;
+static graph_t graph;
+static int graph_mode = 0;  // 0: corpo de texto, 1: acelerômetro XYZ, 2: giroscópio XYZ
+
+// Sensores intercalados pelo escalonador; cada amostra do MPU6050 gera um
+// registro com os últimos valores de todos os sensores
+static sensor_sched_t sensors;
+static sensor_t mpu_sensor, bmp_sensor, aht_sensor, distance_sensor;
+static uint32_t mpu_bit;  // SENSOR_BIT(&mpu_sensor); 0 se o MPU6050 não foi registrado
+static bmp280_t bmp280;
+static aht20_t aht20;
+static ultrasonic_t ultrasonic;
+static char data_header[16 + CSV_MAX_CHANNELS * 12];
 
 int main() {
     stdio_init_all();
     time_init();
+    trace_init();
+    live_stream_init(LIVE_STREAM_DEFAULT_DECIMATION);
 
-    int16_t aceleracao[3], gyro[3], temp;
+    int16_t aceleracao[3], gyro[3];
+    csv_channel_t channels[CSV_MAX_CHANNELS];
     ssd1306_t ssd;
 
     init_btns();
     init_btn(BTN_SW_PIN);
     init_leds();
+
+    // Display dividindo barramento com sensores: os quadros por DMA
+    // corromperiam as leituras, então a captura não começa
+    while (!i2c_bus_check_config()) {
+        printf("Corrija config/i2c_config.c\n");
+        sleep_ms(5000);
+    }
     mpu6050_init();
+    init_sensors();
     init_display(&ssd);
+    i2c_bus_print_map();
+    ui_init(&ui);
+    display_sched_init(&display_sched, DISPLAY_MAX_FPS);
     init_buzzer(BUZZER_A_PIN, 4.0f);  // Inicializa o buzzer com divisor de clock de 4.0
     init_buzzer(BUZZER_B_PIN, 4.0f);  // Inicializa o buzzer com divisor de clock de 4.0
 
@@ -71,35 +117,75 @@ int main() {
                 run_mount();
             } else {
                 printf("Desmontando o cartão SD...\n");
+                flush_data(filename);  // Grava registros pendentes antes de desmontar
                 run_unmount();
             }
         }
 
-        // Leitura dos dados do MPU6050
-        mpu6050_read_raw(aceleracao, gyro, &temp);
+        // Conclui as conversões prontas e dispara as que venceram; nenhum
+        // sensor espera pelo fim da conversão de outro
+        uint32_t fresh = sensor_sched_poll(&sensors, time_us_64());
+
+        if (fresh & mpu_bit) {
+            for (int i = 0; i < 3; i++) {
+                aceleracao[i] = (int16_t)mpu_sensor.values[i];
+                gyro[i] = (int16_t)mpu_sensor.values[3 + i];
+            }
+
+            // O gráfico só acumula mínimo/máximo aqui; desenha na taxa do display
+            if (graph_mode) {
+                graph_push(&graph, graph_mode == 1 ? aceleracao : gyro);
+            }
 
-        // Conversão do valor bruto para graus Celsius
-        float temp_celsius = (temp / 340.0f) + 36.53f;
+            // Captura e salva no cartão SD os últimos valores de todos os sensores
+            if (is_capture_mode && is_mounted) {
+                if (num_samples == 0)
+                    save_health_record(true);  // Contadores no início da captura
+                size_t n = sensor_sched_channels(&sensors, channels);
+                if (save_channels(filename, channels, n)) {
+                    num_samples++;
+                } else if (lost_records++ == 0) {
+                    printf("[ERRO] Falha ao gravar no cartao: registros descartados\n");
+                }
+            }
+        }
 
-        // Captura e salva os dados no cartão SD
+        // Falhas de sensores e barramentos entram no arquivo como metadados; a
+        // captura continua sem as amostras perdidas
         if (is_capture_mode && is_mounted) {
-            save_data(filename, aceleracao, gyro, temp_celsius);
-            num_samples++;
+            save_health_record(false);
+        }
+
+        // Ao fim da captura, grava os registros que ainda estão no buffer
+        if (last_is_capturing && !is_capture_mode && is_mounted) {
+            save_health_record(false);
+            flush_data(filename);
         }
 
         // Atualiza o estado do display
         bool display_needs_update = (last_num_samples != num_samples) ||
                          (last_is_mounted != is_mounted) ||
                          (last_is_capturing != is_capture_mode) ||
-                         showing_temp_message; // Força atualização se mensagem temporária estiver ativa
+                         showing_temp_message || // Força atualização se mensagem temporária estiver ativa
+                         (graph_mode && graph_has_pending(&graph));
 
         if (display_needs_update) {
-            update_display(&ssd);
+            display_sched_request(&display_sched);
             last_num_samples = num_samples;
             last_is_mounted = is_mounted;
             last_is_capturing = is_capture_mode;
         }
 
+        // Mudanças são agrupadas e desenhadas no máximo a DISPLAY_MAX_FPS; perto
+        // de completar um setor no buffer do logger o display cede a vez
+        bool storage_busy = is_capture_mode && pending_data_bytes() >= DISPLAY_STORAGE_WATERMARK;
+        if (display_sched_due(&display_sched, &ssd, storage_busy)) {
+            update_display(&ssd);
+        }
+
+        // Inicia o envio de um quadro adiado enquanto o anterior estava no barramento
+        ssd1306_poll(&ssd);
+
         // Verifica se a mensagem de temperatura deve ser exibida
         if (showing_temp_message) {
             int64_t current_time = to_us_since_boot(get_absolute_time());
@@ -139,6 +225,7 @@ int main() {
 
             is_reading = true;
             update_led_state();  // Atualiza o LED imediatamente
+            flush_data(filename);
             read_file(filename);
 
             message_state = 4;  // Estado para mostrar leitura concluída
@@ -149,11 +236,70 @@ int main() {
             is_reading = false;
         }
 
+        // Envia ao terminal os registros pendentes do stream ao vivo
+        live_stream_poll();
+
+        // Comandos recebidos pelo terminal
+        handle_console_command();
+
         update_led_state();
-        sleep_ms(500);
+
+        // Dorme até o próximo evento dos sensores, acordando periodicamente
+        // para botões, console e display
+        uint64_t now = time_us_64();
+        uint64_t wake = sensor_sched_next_us(&sensors);
+        if (wake > now + MAIN_LOOP_MAX_SLEEP_US)
+            wake = now + MAIN_LOOP_MAX_SLEEP_US;
+        if (wake > now)
+            sleep_us(wake - now);
     }
 }
 
+// Registra os sensores presentes e gera o cabeçalho do arquivo a partir deles;
+// o MPU6050 (já inicializado) define a taxa dos registros
+void init_sensors() {
+    sensor_sched_init(&sensors);
+    if (sensor_sched_add(&sensors, &mpu_sensor, &mpu6050_sensor, NULL, 0))
+        mpu_bit = SENSOR_BIT(&mpu_sensor);
+    else
+        printf("MPU6050 nao encontrado\n");
+    if (!sensor_sched_add(&sensors, &bmp_sensor, &bmp280_sensor, &bmp280, 0))
+        printf("BMP280 nao encontrado\n");
+    if (!sensor_sched_add(&sensors, &aht_sensor, &aht20_sensor, &aht20, 0))
+        printf("AHT20 nao encontrado\n");
+    sensor_sched_add(&sensors, &distance_sensor, &ultrasonic_sensor, &ultrasonic, 0);
+
+    sensor_sched_header(&sensors, data_header, sizeof(data_header));
+    set_data_header(data_header);
+}
+
+// Registro de metadados com os erros e reinicializações dos sensores e os
+// timeouts e recuperações dos barramentos I2C, contados desde o boot. Com
+// force é sempre gravado; senão, só se os contadores mudaram, no máximo a cada
+// HEALTH_RECORD_INTERVAL_US durante a captura e sem esse limite no fim dela.
+void save_health_record(bool force) {
+    static char last_text[CSV_RECORD_MAX_LEN];
+    static uint64_t last_time_us = 0;
+    char text[CSV_RECORD_MAX_LEN];
+    uint64_t now = time_us_64();
+
+    if (!force && is_capture_mode && now - last_time_us < HEALTH_RECORD_INTERVAL_US)
+        return;
+    last_time_us = now;  // Próxima conferência só no próximo intervalo, gravando ou não
+
+    size_t len = sensor_sched_format_health(&sensors, text, sizeof(text));
+    if (len + 1 < sizeof(text)) {
+        text[len++] = ',';
+        i2c_bus_format_health(text + len, sizeof(text) - len);
+    }
+    if (!force && !strcmp(text, last_text))
+        return;
+
+    if (!save_metadata(filename, text))
+        return;  // Tentado de novo no próximo intervalo
+    strcpy(last_text, text);
+}
+
 // Callback para interrupções dos botões
 void gpio_irq_callback(uint gpio, uint32_t events)
 {
@@ -188,11 +334,14 @@ void gpio_irq_callback(uint gpio, uint32_t events)
 
             if (is_capture_mode) {
                 num_samples = 0;
+                lost_records = 0;
                 printf("Modo de captura ativado\n");
                 should_beep_start = true;
             }
             else if (was_capturing && num_samples > 0) {
                 printf("Modo de captura desativado. %d amostras salvas.\n", num_samples);
+                if (lost_records)
+                    printf("%d registros descartados por falha do cartao.\n", lost_records);
 
                 message_state = 1;
                 showing_temp_message = true;
@@ -234,73 +383,52 @@ void update_led_state() {
     }
 }
 
-// Atualiza o display com o estado atual
+// Atualiza o display com o estado atual; a camada de UI redesenha e envia só
+// os widgets que mudaram desde a última chamada
 void update_display(ssd1306_t *ssd) {
-    bool color = true;
-    char status_str[20];
-    char message[30];
-
-    // Exibição no display
-    ssd1306_fill(ssd, !color);
-    ssd1306_rect(ssd, 3, 3, 122, 60, color, !color);
-    ssd1306_line(ssd, 3, 15, 123, 15, color);  // Após título
-    draw_centered_text(ssd, "DATALOGGER", 6);
-    ssd1306_line(ssd, 3, 48, 123, 48, color);  // Antes do status
-
     // Verifica se deve mostrar mensagem temporária
     if (showing_temp_message) {
         if (message_state == 1) {
             // Primeira mensagem
-            draw_centered_text(ssd, "Dados salvos", 30);
+            ui_show_message(&ui, "Dados salvos", 30, NULL, 0);
         } else if (message_state == 2) {
             // Segunda mensagem
+            char message[UI_TEXT_MAX];
             snprintf(message, sizeof(message), "%d amos.", num_samples);
-            draw_centered_text(ssd, message, 22);
-            draw_centered_text(ssd, "salvas", 32);
+            ui_show_message(&ui, message, 22, "salvas", 32);
         } else if (message_state == 3) {
             // Mensagem de erro - SD não montado
-            draw_centered_text(ssd, "ERRO!", 20);
-            draw_centered_text(ssd, "SD nao montado.", 30);
+            ui_show_message(&ui, "ERRO!", 20, "SD nao montado.", 30);
         } else if (message_state == 4) {
             // Mensagem de leitura concluída
-            draw_centered_text(ssd, "Leitura", 20);
-            draw_centered_text(ssd, "concluida!", 30);
+            ui_show_message(&ui, "Leitura", 20, "concluida!", 30);
         } else if (message_state == 5) {
             // Mensagem de leitura em andamento
-            draw_centered_text(ssd, "Lendo", 20);
-            draw_centered_text(ssd, "arquivo...", 30);
-        }
-
-        // Status continua sendo exibido na parte inferior
-        if (is_mounted) {
-            snprintf(status_str, sizeof(status_str), "SD Montado");
+            ui_show_message(&ui, "Lendo", 20, "arquivo...", 30);
         } else {
-            snprintf(status_str, sizeof(status_str), "SD Desmontado");
+            ui_show_message(&ui, NULL, 0, NULL, 0);
         }
+    } else {
+        ui_hide_message(&ui);
     }
-    // Exibição normal quando não há mensagem temporária
-    else {
-        if (is_mounted) {
-            if (is_capture_mode) {
-                // No modo de captura, mostra contagem de amostras
-                char sample_str[20];
-                snprintf(status_str, sizeof(status_str), "Capturando...");
-                draw_centered_text(ssd, "Amostras:", 20);
-                snprintf(sample_str, sizeof(sample_str), "%d", num_samples);
-                draw_centered_text(ssd, sample_str, 30);
-            } else {
-                // Quando não está capturando, só mostra "Aguardando..."
-                snprintf(status_str, sizeof(status_str), "SD Montado");
-                draw_centered_text(ssd, "Aguardando...", 30);
-                // NÃO mostrar número de amostras aqui
-            }
-        } else {
-            snprintf(status_str, sizeof(status_str), "SD Desmontado");
-        }
+
+    // Corpo: contagem de amostras na captura, "Aguardando..." com o SD montado
+    bool capturing = is_mounted && is_capture_mode;
+    ui_set_visible(&ui, UI_FIELD_LABEL, capturing);
+    ui_set_visible(&ui, UI_FIELD_VALUE, capturing);
+    ui_set_number(&ui, UI_FIELD_VALUE, num_samples);
+    ui_set_visible(&ui, UI_IDLE_TEXT, is_mounted && !is_capture_mode);
+
+    // Status continua sendo exibido na parte inferior
+    if (!is_mounted) {
+        ui_set_text(&ui, UI_STATUS, "SD Desmontado", 52);
+    } else if (capturing && !showing_temp_message) {
+        ui_set_text(&ui, UI_STATUS, "Capturando...", 52);
+    } else {
+        ui_set_text(&ui, UI_STATUS, "SD Montado", 52);
     }
 
-    draw_centered_text(ssd, status_str, 52);
-    ssd1306_send_data(ssd);
+    ui_render(&ui, ssd);
 }
 
 // Funções para controle do buzzer
@@ -320,3 +448,70 @@ void beep_stop_capture() {
     sleep_ms(100);
     stop_tone(BUZZER_B_PIN);  // Para o som
 }
+
+// Trata comandos do terminal: 't' imprime o trace, 'r' zera o trace,
+// 's' mostra as estatísticas do stream, dos sensores e do display, 'g'
+// alterna o gráfico do display, 'b' troca o perfil do BMP280, 'i' liga a
+// medição dos tempos de I2C (e, na segunda vez, imprime e desliga) e '0'..'9'
+// define a decimação do stream
+void handle_console_command() {
+    int c = getchar_timeout_us(0);
+
+    if (c == 't') {
+        trace_dump();
+    } else if (c == 'r') {
+        trace_reset();
+        printf("Trace zerado\n");
+    } else if (c == 's') {
+        live_stream_print_stats();
+        sensor_sched_print_stats(&sensors);
+        printf("BMP280: perfil %s, %lu leituras ocupado, %lu reconfiguracoes\n",
+               bmp280.config ? bmp280.config->name : "-", (unsigned long)bmp280.busy_reads,
+               (unsigned long)bmp280.reconfigs);
+        printf("AHT20: %lu erros de CRC, %lu NACKs, %lu medicoes sem resposta\n",
+               (unsigned long)aht20.crc_errors, (unsigned long)aht20.bus_errors,
+               (unsigned long)aht20.busy_timeouts);
+        const i2c_async_stats_t *dma = i2c_async_get_stats();
+        printf("I2C DMA: %lu leituras, %lu bytes, %lu falhas (%lu timeouts), %lu sem DMA\n",
+               (unsigned long)dma->transfers, (unsigned long)dma->bytes, (unsigned long)dma->failures,
+               (unsigned long)dma->timeouts, (unsigned long)dma->blocking);
+        printf("Display: %lu pedidos, %lu quadros, %lu adiados\n",
+               (unsigned long)display_sched.requests, (unsigned long)display_sched.refreshes,
+               (unsigned long)display_sched.deferred);
+    } else if (c == 'i') {
+        if (i2c_bus_measuring()) {
+            i2c_bus_set_measure(false);
+            i2c_bus_print_stats();
+        } else {
+            i2c_bus_set_measure(true);
+            printf("Medicao de I2C ligada; 'i' de novo para o relatorio\n");
+        }
+    } else if (c == 'g') {
+        // Alterna entre texto, gráfico do acelerômetro e gráfico do giroscópio
+        static const int16_t accel_range[3] = {GRAPH_ACCEL_RANGE, GRAPH_ACCEL_RANGE, GRAPH_ACCEL_RANGE};
+        static const int16_t gyro_range[3] = {GRAPH_GYRO_RANGE, GRAPH_GYRO_RANGE, GRAPH_GYRO_RANGE};
+
+        graph_mode = (graph_mode + 1) % 3;
+        if (graph_mode) {
+            graph_init(&graph, 3, graph_mode == 1 ? accel_range : gyro_range);
+            ui_show_graph(&ui, &graph);
+        } else {
+            ui_show_graph(&ui, NULL);
+        }
+        display_sched_request(&display_sched);
+        printf("Display: %s\n", graph_mode == 1 ? "grafico do acelerometro" :
+                                 graph_mode == 2 ? "grafico do giroscopio" : "texto");
+    } else if (c == 'b' && bmp280.config) {
+        // Troca o compromisso entre resolução, taxa e consumo do BMP280
+        bmp280_preset_t next = (bmp280_preset_t)((bmp280.config - bmp280_presets + 1) % BMP280_NUM_PRESETS);
+        if (bmp280_set_preset(&bmp280, next))
+            printf("BMP280: perfil %s (conversao %lu us)\n", bmp280.config->name,
+                   (unsigned long)bmp280.measurement_us);
+    } else if (c >= '0' && c <= '9') {
+        live_stream_set_decimation((uint32_t)(c - '0'));
+        if (c == '0')
+            printf("Stream ao vivo: desligado\n");
+        else
+            printf("Stream ao vivo: decimacao 1/%d\n", c - '0');
+    }
+}
@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""Gera as tabelas de fonte do SSD1306 a partir de fontes BDF.
+
+Cada fonte de saída é descrita por --font nome:arquivo.bdf:modo:escala:faixa
+  modo   mono (largura da célula) ou prop (largura da tinta + 1 coluna)
+  escala 1, 2, 3... (ampliação por vizinho mais próximo)
+  faixa  primeiro-último caractere, ex.: " -~" ou "0-9"
+
+Os glifos são gravados em colunas de páginas (byte k de uma coluna = linhas
+8k..8k+7, bit 0 no topo), o mesmo layout da GDDRAM em endereçamento vertical,
+para que o driver copie bytes sem processar pixels.
+
+Uso:
+  fontgen.py --output font_data.c --font font_8x8:font8x8.bdf:mono:1: -~ ...
+"""
+
+import argparse
+import os
+import sys
+
+
+class BdfFont:
+    def __init__(self, path):
+        self.path = path
+        self.glyphs = {}   # código -> (dwidth, [linhas de pixels da célula])
+        self.ascent = None
+        self.descent = None
+        self.bbox = None
+        self._parse()
+
+    def _parse(self):
+        with open(self.path, encoding="ascii") as f:
+            lines = [line.strip() for line in f]
+
+        i = 0
+        while i < len(lines):
+            fields = lines[i].split()
+            if not fields:
+                i += 1
+                continue
+            key = fields[0]
+            if key == "FONTBOUNDINGBOX":
+                self.bbox = tuple(int(v) for v in fields[1:5])
+            elif key == "FONT_ASCENT":
+                self.ascent = int(fields[1])
+            elif key == "FONT_DESCENT":
+                self.descent = int(fields[1])
+            elif key == "STARTCHAR":
+                i = self._parse_char(lines, i + 1)
+                continue
+            i += 1
+
+        if self.bbox is None:
+            sys.exit(f"{self.path}: FONTBOUNDINGBOX ausente")
+        if self.ascent is None:
+            self.ascent = self.bbox[1] + self.bbox[3]
+        if self.descent is None:
+            self.descent = -self.bbox[3]
+
+    def _parse_char(self, lines, i):
+        encoding = dwidth = None
+        bbx = None
+        while i < len(lines):
+            fields = lines[i].split()
+            i += 1
+            if not fields:
+                continue
+            if fields[0] == "ENCODING":
+                encoding = int(fields[1])
+            elif fields[0] == "DWIDTH":
+                dwidth = int(fields[1])
+            elif fields[0] == "BBX":
+                bbx = tuple(int(v) for v in fields[1:5])
+            elif fields[0] == "BITMAP":
+                rows = []
+                while lines[i] != "ENDCHAR":
+                    rows.append(int(lines[i], 16))
+                    i += 1
+                self._add_glyph(encoding, dwidth, bbx, rows)
+                return i + 1
+        return i
+
+    def _add_glyph(self, encoding, dwidth, bbx, rows):
+        if encoding is None or encoding < 0 or bbx is None:
+            return
+        w, h, xoff, yoff = bbx
+        height = self.ascent + self.descent
+        row_bits = ((w + 7) // 8) * 8
+        cell_width = max(dwidth or w, w + max(xoff, 0))
+
+        cell = [[False] * cell_width for _ in range(height)]
+        for r, bits in enumerate(rows):
+            y = self.ascent - yoff - h + r
+            if not 0 <= y < height:
+                continue
+            for c in range(w):
+                x = xoff + c
+                if 0 <= x < cell_width and bits >> (row_bits - 1 - c) & 1:
+                    cell[y][x] = True
+        self.glyphs[encoding] = (dwidth if dwidth is not None else w, cell)
+
+    @property
+    def height(self):
+        return self.ascent + self.descent
+
+
+def parse_range(spec):
+    if len(spec) == 3 and spec[1] == "-":
+        return ord(spec[0]), ord(spec[2])
+    if len(spec) == 1:
+        return ord(spec), ord(spec)
+    sys.exit(f"faixa inválida: {spec!r}")
+
+
+def build_font(bdf, mode, scale, first, last):
+    """Retorna (altura, larguras, colunas de cada glifo, largura de ausente)."""
+    height = bdf.height * scale
+    pages = (height + 7) // 8
+    widths, glyph_columns = [], []
+
+    for code in range(first, last + 1):
+        dwidth, cell = bdf.glyphs.get(code, (0, [[]] * bdf.height))
+        cell_width = max((len(row) for row in cell), default=0)
+        cols = list(range(cell_width))
+
+        if mode == "prop":
+            ink = [x for x in cols if any(row[x] for row in cell if x < len(row))]
+            if ink:
+                cols = list(range(ink[0], ink[-1] + 1)) + [None]   # + 1 coluna de espaço
+            else:
+                cols = [None] * max(dwidth // 2, 2)                 # espaço: meia célula
+        else:
+            cols = cols[:dwidth] + [None] * max(dwidth - cell_width, 0)
+
+        packed = []
+        for x in cols:
+            for _ in range(scale):
+                column = []
+                for p in range(pages):
+                    byte = 0
+                    for bit in range(8):
+                        y = (p * 8 + bit) // scale
+                        if x is not None and y < bdf.height and x < len(cell[y]) and cell[y][x]:
+                            byte |= 1 << bit
+                    column.append(byte)
+                packed.append(column)
+        widths.append(len(packed))
+        glyph_columns.append(packed)
+
+    space = bdf.glyphs.get(ord(" "))
+    missing = (space[0] if mode == "mono" else max(space[0] // 2, 2)) if space else 4
+    return height, pages, widths, glyph_columns, missing * scale
+
+
+def emit_font(out, name, source, mode, scale, first, last, font):
+    height, pages, widths, glyph_columns, missing = font
+    data, offsets = [], []
+    for columns in glyph_columns:
+        offsets.append(len(data))
+        for column in columns:
+            data.extend(column)
+
+    out.write(f"// {name}: {os.path.basename(source)}, {mode}, escala {scale}, "
+              f"{chr(first)!r}..{chr(last)!r}, {len(data)} bytes\n")
+    out.write(f"static const uint8_t {name}_data[] = {{\n")
+    for code, columns in zip(range(first, last + 1), glyph_columns):
+        flat = [b for column in columns for b in column]
+        label = chr(code) if chr(code) not in "\\" else "barra invertida"
+        out.write("    " + "".join(f"0x{b:02X}, " for b in flat).rstrip() + f" // {label}\n")
+    out.write("};\n")
+    out.write(f"static const uint16_t {name}_offset[] = {{{', '.join(map(str, offsets))}}};\n")
+    out.write(f"static const uint8_t {name}_width[] = {{{', '.join(map(str, widths))}}};\n")
+    out.write(f"const font_t {name} = {{\n"
+              f"    .height = {height},\n"
+              f"    .pages = {pages},\n"
+              f"    .first = {first},\n"
+              f"    .last = {last},\n"
+              f"    .missing_width = {missing},\n"
+              f"    .width = {name}_width,\n"
+              f"    .offset = {name}_offset,\n"
+              f"    .data = {name}_data,\n"
+              f"}};\n\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--output", required=True)
+    parser.add_argument("--font", action="append", required=True,
+                        help="nome:arquivo.bdf:mono|prop:escala:faixa")
+    args = parser.parse_args()
+
+    fonts, cache = [], {}
+    for spec in args.font:
+        parts = spec.split(":", 4)
+        if len(parts) != 5 or parts[2] not in ("mono", "prop"):
+            sys.exit(f"--font inválido: {spec!r}")
+        name, path, mode, scale, chars = parts
+        scale = int(scale)
+        first, last = parse_range(chars)
+        if path not in cache:
+            cache[path] = BdfFont(path)
+        bdf = cache[path]
+        fonts.append((name, path, mode, scale, first, last, build_font(bdf, mode, scale, first, last)))
+
+    with open(args.output, "w", encoding="utf-8") as out:
+        out.write("// Gerado por tools/fontgen.py durante o build; não editar.\n\n")
+        out.write('#include "ssd1306/font.h"\n\n')
+        for name, path, mode, scale, first, last, font in fonts:
+            emit_font(out, name, path, mode, scale, first, last, font)
+
+
+if __name__ == "__main__":
+    main()